@@ -0,0 +1,250 @@
+//
+//  main.cpp
+//  RCHNanoTimerChecks
+//
+//  Regression checks for RCH::NanoTimer, built and run through the demo's CMake project:
+//  cmake -S demo -B build && cmake --build build && ctest --test-dir build
+//
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include the main NanoTimer header file into the project
+#include "../../include/rchnanotimer.h"
+
+// Label handle value the trace file format uses for unlabelled events
+#define UNLABELLED 0xFFFFFFFF
+
+
+// Returns a path for a scratch file in the system's temporary directory.
+const std::string temporaryPath (const std::string& Name)
+{
+    const char* const variables[3] = { "TMPDIR", "TMP", "TEMP" };
+    
+    for (unsigned int variable=0; variable<3; ++variable)
+    {
+        const char* const directory = std::getenv(variables[variable]);
+        
+        if ((directory != nullptr) and (directory[0] != 0))
+        {
+            return std::string(directory) + "/" + Name;
+        }
+    }
+    
+#if defined(_WIN32)
+    return Name;
+#else
+    return "/tmp/" + Name;
+#endif
+}
+
+// Writes a trace file with labelled and unlabelled events whose ticks jump
+// back and forth, reads it back and compares every record with what was written.
+// Then does the same with a timer's saved split time events.
+const bool checkTraceRoundTrip ()
+{
+    const std::string path = temporaryPath("rchnanotimer_check_" + std::to_string(RCH::NanoSystemClock::ticks()) + ".trace");
+    
+    const std::int64_t ticks[6] = { 1000, 250, 250, -40, 7000000000LL, 3 };
+    const unsigned int labels[6] = { 0, UNLABELLED, 1, UNLABELLED, 2, 0 };
+    const unsigned int threads[6] = { 1, 1, 2, 3, 2, 1 };
+    
+    bool passed = true;
+    
+    {
+        RCH::NanoTraceWriter writer;
+        
+        passed = passed and writer.open(path);
+        
+        for (unsigned int event=0; event<6; ++event)
+        {
+            writer.record(ticks[event], labels[event], threads[event]);
+        }
+        
+        writer.labels({ "first", "second", "third" });
+        
+        passed = passed and writer.close();
+    }
+    
+    {
+        RCH::NanoTraceReader reader (path);
+        
+        passed = passed and reader.isValid() and (reader.size() == 6) and (reader.labels() == std::vector<std::string>({ "first", "second", "third" }));
+        
+        unsigned int event = 0;
+        
+        for (RCH::NanoTraceReader::Iterator record=reader.begin(); record!=reader.end(); ++record, ++event)
+        {
+            passed = passed and (event < 6) and (record->ticks == ticks[event]) and (record->label == labels[event]) and (record->thread == threads[event]);
+        }
+        
+        passed = passed and (event == 6);
+    }
+    
+    // A timer's own events, with start and stop labels plus named and unnamed splits
+    RCH::NanoTimer timer;
+    
+    timer.start();
+    timer.split("named");
+    timer.split();
+    timer.stop();
+    
+    passed = passed and timer.save(path);
+    
+    {
+        RCH::NanoTraceReader reader (path);
+        
+        passed = passed and reader.isValid() and (reader.size() == timer.listTimes().size());
+        
+        unsigned int unnamed = 0;
+        
+        for (RCH::NanoTraceReader::Iterator record=reader.begin(); record!=reader.end(); ++record)
+        {
+            if (record->label == UNLABELLED)
+            {
+                ++unnamed;
+            }
+            else
+            {
+                passed = passed and (record->label < reader.labels().size());
+            }
+        }
+        
+        passed = passed and (unnamed == 1) and (std::find(reader.labels().begin(), reader.labels().end(), "named") != reader.labels().end());
+    }
+    
+    std::remove(path.c_str());
+    
+    return passed;
+}
+
+// Lets several threads trace split time events by label handle while they're drained
+// now and then, every event has to be either collected or counted as dropped.
+const bool checkTracedSplits ()
+{
+    const unsigned int threads = 4;
+    const unsigned int splits = 100000;
+    
+    RCH::NanoTimer timer;
+    timer.trace(1024);
+    
+    const RCH::NanoTimer::NanoLabel work = timer.label("work");
+    
+    std::atomic<unsigned int> finished (0);
+    std::vector<std::thread> workers;
+    
+    for (unsigned int thread=0; thread<threads; ++thread)
+    {
+        workers.push_back(std::thread([&timer, &work, &finished] ()
+        {
+            for (unsigned int split=0; split<splits; ++split)
+            {
+                timer.split(work);
+            }
+            
+            ++finished;
+        }));
+    }
+    
+    unsigned long long drained = 0;
+    
+    while (finished < threads)
+    {
+        drained += static_cast<unsigned long long>(timer.drain());
+    }
+    
+    for (unsigned int thread=0; thread<threads; ++thread)
+    {
+        workers[thread].join();
+    }
+    
+    drained += static_cast<unsigned long long>(timer.drain());
+    
+    return (drained + timer.dropped() == static_cast<unsigned long long>(threads) * splits);
+}
+
+// Stops a concurrent timer while several threads keep recording into it,
+// the stop event has to be the latest split of every run anyway.
+const bool checkConcurrentStop ()
+{
+    RCH::NanoTimer timer;
+    timer.concurrent(true);
+    
+    const RCH::NanoTimer::NanoLabel work = timer.label("work");
+    
+    bool passed = true;
+    
+    for (unsigned int run=0; run<100; ++run)
+    {
+        std::atomic<bool> recording (true);
+        std::vector<std::thread> workers;
+        
+        timer.start();
+        
+        for (unsigned int thread=0; thread<3; ++thread)
+        {
+            workers.push_back(std::thread([&timer, &work, &recording] ()
+            {
+                while (recording == true)
+                {
+                    timer.split(work);
+                }
+            }));
+        }
+        
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        
+        timer.stop();
+        recording = false;
+        
+        for (unsigned int thread=0; thread<3; ++thread)
+        {
+            workers[thread].join();
+        }
+        
+        passed = passed and (timer.listIds().back() == "stop") and (timer.time(-1) == timer.time("stop"));
+    }
+    
+    return passed;
+}
+
+// Formats values right below the unit edges in automatic timebase mode,
+// they have to show up in the next unit if rounding carries them over.
+const bool checkAutomaticFormat ()
+{
+    RCH::NanoTimer timer (2,true);
+    timer.timebase.automatic();
+    
+    return (timer.format(999.999) == "1.00 µs") and (timer.format(999999.999) == "1.00 ms") and (timer.format(999999999.999) == "1.00 s") and (timer.format(999.99) == "999.99 ns");
+}
+
+// Runs a check and prints its result, returns true if it passed.
+const bool check (const char* Name, const bool (*Check)())
+{
+    printf("%s... ", Name);
+    
+    const bool passed = Check();
+    
+    printf("%s\n", (passed == true) ? "passed" : "FAILED");
+    
+    return passed;
+}
+
+
+// Mainline
+int main (int argc, const char * argv[])
+{
+    unsigned int failed = 0;
+    
+    failed += (check("Trace file round trip", checkTraceRoundTrip) == false);
+    failed += (check("Multi-threaded tracing", checkTracedSplits) == false);
+    failed += (check("Concurrent stop", checkConcurrentStop) == false);
+    failed += (check("Automatic format units", checkAutomaticFormat) == false);
+    
+    printf("\n%u check(s) failed.\n", failed);
+    
+    return (failed == 0) ? 0 : 1;
+    
+} // end int main
@@ -27,9 +27,9 @@ int main (int argc, const char * argv[])
     printf("  Attempting to answer the age old question:\n");
     printf("  > Which kind of loop executes faster?\n\n\n");
     
-    // Set up a nanosecond timer with .xxxxxx precision and ns label
-    RCH::NanoTimer nano (6,true);
-    nano.timebase.nanoseconds();
+    // Set up a millisecond timer with .xxx precision and ms label
+    RCH::NanoTimer nano (3,true);
+    nano.timebase.milliseconds();
     
 // =================================================================================
 // TESTING
@@ -17,6 +17,9 @@ void loopForwardIncrementPost ()
     for (unsigned int step=0; step<LOOP_LIMIT; step++)
     {
         accumulator++;
+        
+        // Keep the compiler from collapsing the loop, since accumulator is never read
+        RCH::NanoBarrier::doNotOptimize(accumulator);
     }
 }
 
@@ -29,6 +32,9 @@ void loopForwardIncrementPre ()
     for (unsigned int step=0; step<LOOP_LIMIT; ++step)
     {
         accumulator++;
+        
+        // Keep the compiler from collapsing the loop, since accumulator is never read
+        RCH::NanoBarrier::doNotOptimize(accumulator);
     }
 }
 
@@ -41,6 +47,9 @@ void loopBackwardDecrementPost ()
     for (unsigned int step=LOOP_LIMIT; step>0; step--)
     {
         accumulator++;
+        
+        // Keep the compiler from collapsing the loop, since accumulator is never read
+        RCH::NanoBarrier::doNotOptimize(accumulator);
     }
 }
 
@@ -53,6 +62,9 @@ void loopBackwardDecrementPre ()
     for (unsigned int step=LOOP_LIMIT; step>0; --step)
     {
         accumulator++;
+        
+        // Keep the compiler from collapsing the loop, since accumulator is never read
+        RCH::NanoBarrier::doNotOptimize(accumulator);
     }
 }
 
@@ -65,7 +77,7 @@ const std::string get (std::vector<std::string>& Test, const unsigned int& Run)
     
     const int remainder = 16 - static_cast<int>(padded.length()) - 1;
     
-    for (unsigned int pos=0; pos<remainder; ++pos)
+    for (int pos=0; pos<remainder; ++pos)
     {
         padded.append(" ");
     }
@@ -30,13 +30,86 @@
 
 
 // Include C++ dependencies
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <ratio>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+// MSVC needs this for _ReadWriteBarrier() in the optimizer barriers
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+// The binary trace reader maps trace files into memory
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+// CPU pinning, scheduling priority and frequency governor detection for benchmark runs
+#if defined(__linux__)
+    #include <cerrno>
+    #include <fstream>
+    #include <sched.h>
+    #include <sys/resource.h>
+#endif
+
+
+// Hardware performance counters are read through perf events, which only Linux has
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+#endif
+
+
+// The TSC clock backend reads the x86 time stamp counter directly.
+// On other architectures it falls back to std::chrono::steady_clock.
+#if defined(__x86_64__) or defined(__i386__) or defined(_M_X64) or defined(_M_IX86)
+    #define RCH_NANOTIMER_HAS_TSC 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+        #include <x86intrin.h>
+    #endif
+#else
+    #define RCH_NANOTIMER_HAS_TSC 0
+#endif
+
 
-// The number format used for timestamps and return values.
+// The default number format used for returned timestamps and intervals.
+//
+// Timestamps are always stored as integer clock ticks, and intervals are
+// always calculated from those integer ticks, so this type only affects
+// the scaled output values. Every timer can pick its own format through
+// the BasicNanoTimer template argument, this is just the default that
+// plain RCH::NanoTimer instances use.
 //
 // The double type has floating point precision and a value range that
 // can very easily handle even huge nanosecond precision timestamps.
@@ -50,6 +123,20 @@
 #define RCH_NANOTIMER_DEFAULT_PRECISION     6       // format() --> post comma floating point remainder amount
 #define RCH_NANOTIMER_DEFAULT_DISPLAYLABEL  true    // format() --> append timebase label to output string
 
+// How many back-to-back splits calibrate() records to measure the timer's own overhead.
+#define RCH_NANOTIMER_DEFAULT_CALIBRATION_SAMPLES   10000
+
+// Default settings for statistical benchmark runs through measure().
+#define RCH_NANOTIMER_DEFAULT_WARMUP        10          // measure() --> batches to run before sampling
+#define RCH_NANOTIMER_DEFAULT_MINSAMPLES    10          // measure() --> always take at least this many samples
+#define RCH_NANOTIMER_DEFAULT_MAXSAMPLES    1000000     // measure() --> never take more than this many samples
+#define RCH_NANOTIMER_DEFAULT_BUDGET        1000000000  // measure() --> nanoseconds to keep sampling for
+#define RCH_NANOTIMER_DEFAULT_CONFIDENCE    0.0         // measure() --> stop early at this 95% confidence interval width (relative to mean)
+#define RCH_NANOTIMER_RESOLUTION_FACTOR     1000        // measure() --> samples should take this many times the clock resolution
+#define RCH_NANOTIMER_DEFAULT_SCALING_BUDGET 200000000  // scaling() --> nanoseconds every thread count runs for
+#define RCH_NANOTIMER_DEFAULT_BATCH_SAMPLES 10          // batch() --> batches every batched benchmark() call times
+#define RCH_NANOTIMER_SUITE_BAR_LENGTH      30          // suiteTable() --> characters of the fastest case's throughput bar
+
 // Text labels to use when outputting formatted timer values.
 #define RCH_NANOTIMER_LABELS_NANOSECONDS    " ns"
 #define RCH_NANOTIMER_LABELS_MICROSECONDS   " µs"
@@ -67,777 +154,5863 @@
 #define RCH_NANOTIMER_MINUTES               60000000000.000000
 #define RCH_NANOTIMER_HOURS                 3600000000000.000000
 
+// Timebase unit indices, in the same order as the factors above.
+// Not really user options, but easier to handle in code as defines.
+#define RCH_NANOTIMER_UNIT_NANOSECONDS      0
+#define RCH_NANOTIMER_UNIT_MICROSECONDS     1
+#define RCH_NANOTIMER_UNIT_MILLISECONDS     2
+#define RCH_NANOTIMER_UNIT_SECONDS          3
+#define RCH_NANOTIMER_UNIT_MINUTES          4
+#define RCH_NANOTIMER_UNIT_HOURS            5
+#define RCH_NANOTIMER_UNIT_AUTOMATIC        6
+
+// Longest text format() can produce: sign, 20 whole digits, dot, 18 post-comma digits and a label
+#define RCH_NANOTIMER_FORMAT_LENGTH         64
+
 // Just a convenience define
 #define RCH_NANOTIMER_TIMESTAMP std::chrono::high_resolution_clock::time_point
 
+// Integer type that holds raw clock ticks of stored split time events
+#define RCH_NANOTIMER_TICKS std::int64_t
+
+// How the TSC clock backend calibrates its ticks against std::chrono::steady_clock.
+// The median of several rounds is used, their spread is reported as calibration error.
+#define RCH_NANOTIMER_TSC_CALIBRATION_ROUNDS    5
+#define RCH_NANOTIMER_TSC_CALIBRATION_SPAN      10000000    // nanoseconds per calibration round
+
+// Default resolution and range of latency histograms.
+#define RCH_NANOTIMER_DEFAULT_HISTOGRAM_DIGITS      3                   // NanoHistogram --> significant decimal digits kept per value
+#define RCH_NANOTIMER_DEFAULT_HISTOGRAM_HIGHEST     3600000000000ULL    // NanoHistogram --> largest trackable value in nanoseconds (1 h)
+
+// Defaults for deciding whether two sets of samples really differ.
+#define RCH_NANOTIMER_DEFAULT_SIGNIFICANCE          0.05    // NanoComparison --> highest p-value that counts as a real difference
+#define RCH_NANOTIMER_DEFAULT_THRESHOLD             0.02    // NanoComparison --> smallest relative change of the median that matters
+#define RCH_NANOTIMER_DEFAULT_RESAMPLES             1000    // NanoComparison --> bootstrap resamples for the confidence interval
+
+// How many encoded bytes a trace writer collects before handing them to the file in one write.
+#define RCH_NANOTIMER_TRACE_BUFFER                  1048576
+
+// How many concurrent or tracing timers every thread remembers its own buffer for.
+#define RCH_NANOTIMER_BUFFER_CACHE                  8
+
+// Label handle value used for splits that were recorded without an ID.
+// Their names are resolved to sequential numbers when queried.
+#define RCH_NANOTIMER_UNLABELLED            0xFFFFFFFF
+
+// Label handles that are always reserved for the default start and stop IDs.
+#define RCH_NANOTIMER_LABEL_START           0
+#define RCH_NANOTIMER_LABEL_STOP            1
+
 /** RCH classes are in here */
 namespace RCH
 {
-    /** Creates a high precision timer. */
-    class NanoTimer
+// ------------------------------------------------------------------------------------------
+// THREAD IDENTIFICATION
+    
+    struct NanoThread
     {
-    public:
-        
-        NanoTimer () {}
-        
-        /** Constructor that overrides decimal precision and label display formatting */
-        NanoTimer (const unsigned int& Precision, const bool& DisplayLabel)
+        /** Returns a small sequential ID for the calling thread, starting at 1.
+            Every split time event is tagged with the ID of the thread that recorded it. */
+        static const unsigned int id ()
         {
-            formatting.precision = Precision;
-            formatting.label = DisplayLabel;
+            static std::atomic<unsigned int> counter (0);
+            static thread_local const unsigned int threadID = ++counter;
+            
+            return threadID;
         }
         
-        ~NanoTimer () {}
+        /** Returns a process wide unique number, used to tell apart the owners of thread local buffers. */
+        static const unsigned long long owner ()
+        {
+            static std::atomic<unsigned long long> counter (0);
+            
+            return ++counter;
+        }
         
+    }; // end struct RCH::NanoThread
+    
 // ------------------------------------------------------------------------------------------
-// TIMEBASE FACTOR
+// CPU ISOLATION
+// The scheduler may move a thread to another core at any time, and cores may change their clock
+// speed. Both add variance to measurements, so benchmark runs can pin themselves to one core.
+    
+    struct NanoCpu
+    {
+        /** Returns the CPU the calling thread is running on right now, or -1 if that's unknown. */
+        static const int current ()
+        {
+#if defined(__linux__)
+            return sched_getcpu();
+#elif defined(_WIN32)
+            return static_cast<int>(GetCurrentProcessorNumber());
+#else
+            return -1;
+#endif
+        }
         
-        /** Contains methods to switch the timer's time base for retrieved values.
-            The timer will always store full precision nanosecond based timestamps,
-            but the timebase can be used to scale output values to other timebases
-            like milliseconds or full seconds. */
-        struct Timebase
+        /** Returns the name of a CPU's frequency scaling governor (e.g. "performance" or "powersave"),
+            or an empty string if that's unknown. Only Linux reports this. */
+        static const std::string governor (const int& Cpu)
         {
-        private:
+            std::string name;
             
-            // The currently set time base, nanoseconds by default
-            RCH_NANOTIMER_DATATYPE timefactor = RCH_NANOTIMER_NANOSECONDS;
+#if defined(__linux__)
+            if (Cpu > -1)
+            {
+                std::ifstream file ("/sys/devices/system/cpu/cpu" + std::to_string(Cpu) + "/cpufreq/scaling_governor");
+                std::getline(file, name);
+            }
+#endif
             
-        public:
+            return name;
+        }
+        
+    }; // end struct RCH::NanoCpu
+    
+    /** Pins the calling thread to one CPU and optionally raises its scheduling priority, for as long as
+        this object exists. Both are restored when it's destroyed. Anything that isn't permitted or not
+        supported on this platform is silently left alone, check pinned() and prioritized(). */
+    class NanoIsolation
+    {
+    public:
+        
+        explicit NanoIsolation (const int& Cpu, const bool& RaisePriority=false)
+        {
+#if defined(__linux__)
+            cpu_set_t wanted;
+            CPU_ZERO(&wanted);
             
-            /** Returns the currently set timebase factor by which the original
-                full precision timestamps are divided when output. */
-            const RCH_NANOTIMER_DATATYPE& factor () const
+            if ((Cpu > -1) and (Cpu < CPU_SETSIZE) and (sched_getaffinity(0, sizeof(cpu_set_t), &affinity) == 0))
             {
-                return timefactor;
+                CPU_SET(Cpu, &wanted);
+                
+                isPinned = (sched_setaffinity(0, sizeof(cpu_set_t), &wanted) == 0);
             }
             
-            /** Switches the timebase to nanoseconds. */
-            void nanoseconds ()
+            // On Linux, a "process" priority of 0 refers to the calling thread only
+            if (RaisePriority == true)
             {
-                timefactor = RCH_NANOTIMER_NANOSECONDS;
+                errno = 0;
+                niceness = getpriority(PRIO_PROCESS, 0);
+                
+                isPrioritized = (errno == 0) and (setpriority(PRIO_PROCESS, 0, -20) == 0);
             }
-            
-            /** Switches the timebase to microseconds. */
-            void microseconds ()
+#elif defined(_WIN32)
+            if ((Cpu > -1) and (Cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)))
             {
-                timefactor = RCH_NANOTIMER_MICROSECONDS;
+                affinity = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << Cpu);
+                
+                isPinned = (affinity != 0);
             }
             
-            /** Switches the timebase to milliseconds. */
-            void milliseconds ()
+            if (RaisePriority == true)
             {
-                timefactor = RCH_NANOTIMER_MILLISECONDS;
+                priority = GetThreadPriority(GetCurrentThread());
+                
+                isPrioritized = (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != 0);
             }
-            
-            /** Switches the timebase to seconds. */
-            void seconds ()
+#else
+            static_cast<void>(Cpu);
+            static_cast<void>(RaisePriority);
+#endif
+        }
+        
+        ~NanoIsolation ()
+        {
+#if defined(__linux__)
+            if (isPinned == true)
             {
-                timefactor = RCH_NANOTIMER_SECONDS;
+                sched_setaffinity(0, sizeof(cpu_set_t), &affinity);
             }
             
-            /** Switches the timebase to minutes. */
-            void minutes ()
+            if (isPrioritized == true)
             {
-                timefactor = RCH_NANOTIMER_MINUTES;
+                setpriority(PRIO_PROCESS, 0, niceness);
             }
-            
-            /** Switches the timebase to hours. */
-            void hours ()
+#elif defined(_WIN32)
+            if (isPinned == true)
             {
-                timefactor = RCH_NANOTIMER_HOURS;
+                SetThreadAffinityMask(GetCurrentThread(), affinity);
             }
             
-        } timebase;
+            if (isPrioritized == true)
+            {
+                SetThreadPriority(GetCurrentThread(), priority);
+            }
+#endif
+        }
+        
+        /** Returns true if the thread was actually pinned to the CPU. */
+        const bool pinned () const
+        {
+            return isPinned;
+        }
+        
+        /** Returns true if the thread's priority was actually raised. */
+        const bool prioritized () const
+        {
+            return isPrioritized;
+        }
+        
+    private:
+        
+        NanoIsolation (const NanoIsolation&) = delete;
+        NanoIsolation& operator= (const NanoIsolation&) = delete;
+        
+        bool isPinned = false;
+        bool isPrioritized = false;
         
+        // What to restore when done
+#if defined(__linux__)
+        cpu_set_t affinity;
+        int niceness = 0;
+#elif defined(_WIN32)
+        DWORD_PTR affinity = 0;
+        int priority = THREAD_PRIORITY_NORMAL;
+#endif
+        
+    }; // end class RCH::NanoIsolation
+    
 // ------------------------------------------------------------------------------------------
-// FORMAT / BEAUTIFY OUTPUT
+// HARDWARE COUNTERS
+// Wall time tells that code is slow, CPU counters help tell why: few instructions per cycle point at
+// stalls, and cache or branch misses at what causes them. Counters are read through Linux perf events,
+// everywhere else (or when perf events aren't permitted, as in many containers) they all stay zero.
+    
+    /** Counts of CPU events, either raw totals at one point in time or the difference between two of those.
+        Values are doubles, because differences of counts shared with other perf event users are extrapolated. */
+    struct NanoCounters
+    {
+        double cycles = 0.0;
+        double instructions = 0.0;
+        double cacheMisses = 0.0;
+        double branchMisses = 0.0;
         
-        /** Sets up the timer's formatting precision in post-comma floating point steps, and
-            whether or not to display a text label at the end of formatted value strings. */
-        void format (const unsigned int& Precision, const bool& DisplayLabel)
+        // Nanoseconds the counters were enabled, and actually counting on the CPU. Other perf event users
+        // may push the counters off the CPU for a while, since() extrapolates over that time.
+        double enabled = 0.0;
+        double running = 0.0;
+        
+        // False if the counters couldn't be read at all, then all values are zero.
+        // Events a CPU doesn't support stay zero even if this is true.
+        bool valid = false;
+        
+        /** Returns the instructions per cycle, or zero if no cycles were counted. */
+        const double ipc () const
         {
-            formatting.precision = Precision;
-            formatting.label = DisplayLabel;
+            return (cycles > 0.0) ? instructions / cycles : 0.0;
         }
         
-        /** Takes a timer value and returns it formatted according to current formatting options. */
-        const std::string format (const RCH_NANOTIMER_DATATYPE& Time) const
+        /** Returns the counts that happened between an Earlier reading and this one, extrapolated from
+            the time the counters were actually running in between. Invalid if they never ran in between. */
+        const NanoCounters since (const NanoCounters& Earlier) const
         {
-            // Calculate the factor for rounding
-            const RCH_NANOTIMER_DATATYPE roundFactor = std::pow(10,formatting.precision);
-            
-            // Turn the rounded number value into a string
-            std::string value = std::to_string(std::round(Time * roundFactor) / roundFactor);
-            
-            // To avoid compiler warnings about type mismatch between int / iterator
-            const unsigned int valueLength = static_cast<unsigned int>(value.length());
+            NanoCounters result;
             
-            // The position/index of the dot character in the timer value string
-            const int dot = static_cast<int>(value.find("."));
+            result.enabled = enabled - Earlier.enabled;
+            result.running = running - Earlier.running;
+            result.valid = valid and Earlier.valid and ((result.running > 0.0) or (result.enabled == 0.0));
             
-            if (dot > -1)
+            if (result.valid == true)
             {
-                // Evaluate how many post-comma floating point steps will be left
-                unsigned int precision = formatting.precision + (formatting.precision > 0);
+                const double share = (result.running > 0.0) ? result.enabled / result.running : 1.0;
                 
-                // Ensure that the maximum precision offset is limited to actually available characters
-                if (precision > valueLength - dot)
-                {
-                    precision = valueLength - dot;
-                }
-                
-                // Remove any trailing numbers from the value string if outside of precision
-                value.erase(dot + precision, std::string::npos);
-            }
-            
-            // If a text label should be added to the end of the string
-            if (formatting.label == true)
-            {
-                // Pick the appropriate label for the current timebase and append it
-                if (timebase.factor() == RCH_NANOTIMER_NANOSECONDS)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_NANOSECONDS);
-                }
-                else if (timebase.factor() == RCH_NANOTIMER_MICROSECONDS)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_MICROSECONDS);
-                }
-                else if (timebase.factor() == RCH_NANOTIMER_MILLISECONDS)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_MILLISECONDS);
-                }
-                else if (timebase.factor() == RCH_NANOTIMER_SECONDS)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_SECONDS);
-                }
-                else if (timebase.factor() == RCH_NANOTIMER_MINUTES)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_MINUTES);
-                }
-                else if (timebase.factor() == RCH_NANOTIMER_HOURS)
-                {
-                    value += std::string(RCH_NANOTIMER_LABELS_HOURS);
-                }
+                result.cycles = (cycles - Earlier.cycles) * share;
+                result.instructions = (instructions - Earlier.instructions) * share;
+                result.cacheMisses = (cacheMisses - Earlier.cacheMisses) * share;
+                result.branchMisses = (branchMisses - Earlier.branchMisses) * share;
             }
             
-            // Output the formatted value as a string
-            return value;
+            return result;
         }
         
-        /** Takes a timer value along with formatting arguments and returns it formatted as specified.
-            This will update the timer's formatting options and affect later calls to format(). */
-        const std::string format (const RCH_NANOTIMER_DATATYPE& Time, const int& Precision, const bool& DisplayLabel)
+        /** Adds the counts of an Other reading, e.g. to total up several intervals. */
+        void add (const NanoCounters& Other)
         {
-            // Update formatting settings first
-            format(Precision,DisplayLabel);
+            cycles += Other.cycles;
+            instructions += Other.instructions;
+            cacheMisses += Other.cacheMisses;
+            branchMisses += Other.branchMisses;
+            enabled += Other.enabled;
+            running += Other.running;
             
-            // Then return the formatted time value as a string
-            return format(Time);
+            valid = valid and Other.valid;
         }
         
-// ------------------------------------------------------------------------------------------
-// RESET
-        
-        /** Hard reset, stops the timer if currently running and deletes all saved split time events. */
-        void reset ()
+        /** Returns the counts divided by a number of Calls, e.g. to get cache misses per iteration.
+            The enabled and running times are left as they are. */
+        const NanoCounters perCall (const unsigned long long& Calls) const
         {
-            // Reset the running flag to "not running" state
-            running = false;
+            NanoCounters result (*this);
             
-            // Remove all currently saved split time events
-            splits.clear();
-        }
-        
-// ------------------------------------------------------------------------------------------
-// OPERATION
-        
-        /** Adds a new split time event to the list without stopping the timer.
-            Accepts a string argument ID to help identify this split time event.
-            If no string is passed, uses sequential numbers as IDs. */
-        const RCH_NANOTIMER_DATATYPE split (std::string ID="")
-        {
-            // Only add splits
-            if (running == true)
+            if (Calls > 0)
             {
-                // Make the ID argument lowercase
-                std::transform(ID.begin(), ID.end(), ID.begin(), ::tolower);
-                
-                // Add a new {ID,time} record as the latest split
-                splits.push_back(NanoSplit(((ID == "") ? std::to_string(numSplits() + 1) : ID), now()));
-                
-                // Return the scaled (not formatted) timestamp of the just added split event time
-                return scale(splits.back().time);
+                result.cycles /= static_cast<double>(Calls);
+                result.instructions /= static_cast<double>(Calls);
+                result.cacheMisses /= static_cast<double>(Calls);
+                result.branchMisses /= static_cast<double>(Calls);
             }
             
-            // Return zero if the timer is currently not running
-            return zero();
+            return result;
         }
         
-        /** Starts a new timer run.
-            Does a full reset beforehand, all previously stored splits will be deleted.
-            Accpets a string argument ID to help identify this timer start event.
-            If no string is passed, uses "start" as the split identifier. */
-        const RCH_NANOTIMER_DATATYPE start (std::string ID="")
+    }; // end struct RCH::NanoCounters
+    
+    /** Counts CPU events of the thread that created it, from construction until it's destroyed.
+        Copies count for the thread that makes the copy. Only user space events are counted, which
+        is what unprivileged processes are allowed to count with the default perf event settings. */
+    class NanoCounterGroup
+    {
+    public:
+        
+        NanoCounterGroup ()
         {
-            // Erase the slate
-            reset();
-            
-            // Flag the timer as "running" from now on
-            running = true;
-            
-            // Create a new split time event using the passed ID, fall back to "start" if none passed
-            split((ID == "") ? "start" : ID);
-            
-            // Return the scaled (not formatted) timestamp of the just added start event time
-            return scale(splits.front().time);
+            open();
         }
         
-        /** Stops the timer completely.
-            It will not be possible to add new splits anymore, except after reset() or new start().
-            Accepts a string argument ID to help identify this timer stop event.
-            If no string is passed, uses "stop" as the split identifier. */
-        const RCH_NANOTIMER_DATATYPE stop (std::string ID="")
+        NanoCounterGroup (const NanoCounterGroup&) : NanoCounterGroup() {}
+        
+        ~NanoCounterGroup ()
         {
-            // It's only possible to trigger a stop event while the timer is actually running
-            if (running == true)
+#if defined(__linux__)
+            for (unsigned int event=0; event<opened; ++event)
             {
-                // Create a new split time event using the passed ID, fall back to "stop" if none passed
-                split((ID == "") ? "stop" : ID);
-                
-                // Flat the timer as "not running" from now on
-                running = false;
-                
-                // Return the scaled (not formatted) timestamp of the just added stop event time
-                return scale(splits.back().time);
+                close(descriptors[event]);
             }
-            
-            // Return zero if the timer is currently not running
-            return zero();
+#endif
         }
         
-// ------------------------------------------------------------------------------------------
-// SPECIFIC POINTS IN TIME
-        
-        /** Returns the current timestamp in full nanosecond precision. */
-        const RCH_NANOTIMER_TIMESTAMP now () const
+        /** Returns true if at least one counter could be opened. */
+        const bool isValid () const
         {
-            return std::chrono::high_resolution_clock::now();
+            return (opened > 0);
         }
         
-        /** Selects and returns (scaled, not formatted) a specific split time event by its numerical index.
-            The index Number can be negative to select an index counting from the back. (-1 for last) */
-        const RCH_NANOTIMER_DATATYPE time (const int& Number) const
+        /** Reads the raw totals of all counters at once, use NanoCounters::since() to get the counts in between
+            two readings. Costs one system call, the result is invalid if reading failed. */
+        const NanoCounters read () const
         {
-            // If there are no split time events saved anyway, including start or stop
-            if (numSplits() == 0)
-            {
-                // Exit early
-                return zero();
-            }
+            NanoCounters result;
             
-            // Handle special cases for start and stop splits directly
-            if (Number == 0)
-            {
-                return scale(splits.front().time);
-            }
-            else if (Number == -1)
+#if defined(__linux__)
+            if (opened == 0)
             {
-                return scale(splits.back().time);
+                return result;
             }
             
-            // Since the index Number can be negative, figure out an actual positive array index
-            const int splitIndex = Number + (Number < 0) * numSplits();
+            // Group reads return the number of events, the enabled and running times, then one value per event
+            std::uint64_t values[3 + 4] = {};
             
-            // If a valid and correctly bounded split index was found
-            if ((splitIndex > -1) && (splitIndex < numSplits()))
-            {
-                // Return the scaled (not formatted) timestamp of the split at the found index
-                return scale(splits[splitIndex].time);
-            }
+            const ssize_t size = ::read(descriptors[0], values, sizeof(values));
             
-            // If no split record was found at the queried index, then return zero as default
-            return zero();
-        }
-        
-        /** Looks through all saved split time events and searches for a specific string ID.
-            Returns the split's scaled (not formatted) timestamp value, if found. */
-        const RCH_NANOTIMER_DATATYPE time (std::string SplitID) const
-        {
-            // If there are no split time events saved anyway, including start or stop
-            if (numSplits() == 0)
+            if (size < static_cast<ssize_t>((3 + opened) * sizeof(std::uint64_t)))
             {
-                // Exit early
-                return zero();
+                return result;
             }
             
-            // Fetch the split index for this split ID
-            const int index = indexFromSplitID(SplitID);
+            result.enabled = static_cast<double>(values[1]);
+            result.running = static_cast<double>(values[2]);
             
-            // If a valid index for this split ID was found
-            if (index > -1)
+            double* const fields[4] = { &result.cycles, &result.instructions, &result.cacheMisses, &result.branchMisses };
+            
+            for (unsigned int event=0; event<opened; ++event)
             {
-                return time(index);
+                *fields[events[event]] = static_cast<double>(values[3 + event]);
             }
             
-            // If no split record was found to match the queried ID, then return zero as default
-            return zero();
+            result.valid = true;
+#endif
+            
+            return result;
         }
         
-// ------------------------------------------------------------------------------------------
+    private:
+        
+        NanoCounterGroup& operator= (const NanoCounterGroup&) = delete;
+        
+        // Opens every supported counter as one group, so they're all scheduled and read together
+        void open ()
+        {
+#if defined(__linux__)
+            const std::uint64_t configs[4] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+            
+            for (unsigned int event=0; event<4; ++event)
+            {
+                perf_event_attr attributes;
+                std::memset(&attributes, 0, sizeof(perf_event_attr));
+                
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.size = sizeof(perf_event_attr);
+                attributes.config = configs[event];
+                attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                
+                // The first counter that opens leads the group, unsupported events are skipped
+                const long descriptor = syscall(__NR_perf_event_open, &attributes, 0, -1, (opened > 0) ? descriptors[0] : -1, 0);
+                
+                if (descriptor > -1)
+                {
+                    descriptors[opened] = static_cast<int>(descriptor);
+                    events[opened] = event;
+                    
+                    ++opened;
+                }
+            }
+#endif
+        }
+        
+        // Open counter file descriptors, the group leader first, and which NanoCounters field each one counts
+        int descriptors[4] = { -1, -1, -1, -1 };
+        unsigned int events[4] = { 0, 0, 0, 0 };
+        unsigned int opened = 0;
+        
+    }; // end class RCH::NanoCounterGroup
+    
+// ------------------------------------------------------------------------------------------
+// OPTIMIZER BARRIERS
+// Code whose results are never used may be removed by the compiler entirely, so a benchmark would
+// end up timing nothing. These barriers make the compiler believe results are used and memory is read.
+    
+    struct NanoBarrier
+    {
+        /** Makes the compiler assume Value is read, so whatever computed it can't be optimized away. */
+        template <class TYPE>
+        static inline void doNotOptimize (const TYPE& Value)
+        {
+#if defined(_MSC_VER)
+            sink(&Value);
+#else
+            asm volatile ("" : : "r,m" (Value) : "memory");
+#endif
+        }
+        
+        /** Makes the compiler assume Value is read and modified, so it has to be kept up to date
+            (e.g. an accumulator in a loop), and can't be treated as a known constant afterwards. */
+        template <class TYPE>
+        static inline typename std::enable_if<std::is_trivially_copyable<TYPE>::value and (sizeof(TYPE) <= sizeof(TYPE*))>::type doNotOptimize (TYPE& Value)
+        {
+#if defined(_MSC_VER)
+            sink(&Value);
+#elif defined(__clang__)
+            asm volatile ("" : "+r,m" (Value) : : "memory");
+#else
+            asm volatile ("" : "+m,r" (Value) : : "memory");
+#endif
+        }
+        
+        /** Same as above, for values too large (or not simple enough) to live in a register. */
+        template <class TYPE>
+        static inline typename std::enable_if<(std::is_trivially_copyable<TYPE>::value == false) or (sizeof(TYPE) > sizeof(TYPE*))>::type doNotOptimize (TYPE& Value)
+        {
+#if defined(_MSC_VER)
+            sink(&Value);
+#else
+            asm volatile ("" : "+m" (Value) : : "memory");
+#endif
+        }
+        
+        /** Makes the compiler assume Value's memory may have been read and changed, because its address
+            escaped. Unlike doNotOptimize(), this also works for const values and objects of any size. */
+        template <class TYPE>
+        static inline void escape (const TYPE& Value)
+        {
+#if defined(_MSC_VER)
+            sink(&Value);
+#else
+            asm volatile ("" : : "r" (&Value) : "memory");
+#endif
+        }
+        
+        /** Makes the compiler assume all memory may have been read and written,
+            so pending writes can't be dropped and values have to be read again. */
+        static inline void clobberMemory ()
+        {
+#if defined(_MSC_VER)
+            _ReadWriteBarrier();
+#else
+            asm volatile ("" : : : "memory");
+#endif
+        }
+        
+    private:
+        
+#if defined(_MSC_VER)
+        // MSVC has no inline assembly on x64, so the value's address escapes into a volatile instead
+        static inline void sink (const volatile void* Address)
+        {
+            static const volatile void* volatile escaped = nullptr;
+            
+            escaped = Address;
+            
+            _ReadWriteBarrier();
+        }
+#endif
+        
+    }; // end struct RCH::NanoBarrier
+    
+// ------------------------------------------------------------------------------------------
+// INVOCATION HELPERS
+// benchmark() calls functions, lambdas, functors and member functions through these, directly and
+// without std::function or similar wrappers, so no extra indirection ends up in the measured time.
+    
+    struct NanoInvoke
+    {
+        /** Calls a function, lambda or functor with the passed arguments. */
+        template <class FUNCTION, class... ARGUMENTS>
+        static auto call (FUNCTION&& Function, ARGUMENTS&&... Arguments)
+            -> decltype(std::forward<FUNCTION>(Function)(std::forward<ARGUMENTS>(Arguments)...))
+        {
+            return std::forward<FUNCTION>(Function)(std::forward<ARGUMENTS>(Arguments)...);
+        }
+        
+        /** Calls a member function on an object, or a reference to one. */
+        template <class MEMBER, class CLASS, class OBJECT, class... ARGUMENTS>
+        static auto call (MEMBER CLASS::* Member, OBJECT&& Object, ARGUMENTS&&... Arguments)
+            -> decltype((std::forward<OBJECT>(Object).*Member)(std::forward<ARGUMENTS>(Arguments)...))
+        {
+            return (std::forward<OBJECT>(Object).*Member)(std::forward<ARGUMENTS>(Arguments)...);
+        }
+        
+        /** Calls a member function on a pointer to an object. */
+        template <class MEMBER, class CLASS, class OBJECT, class... ARGUMENTS>
+        static auto call (MEMBER CLASS::* Member, OBJECT* Object, ARGUMENTS&&... Arguments)
+            -> decltype((Object->*Member)(std::forward<ARGUMENTS>(Arguments)...))
+        {
+            return (Object->*Member)(std::forward<ARGUMENTS>(Arguments)...);
+        }
+        
+        /** The type that calling FUNCTION with ARGUMENTS returns. */
+        template <class FUNCTION, class... ARGUMENTS>
+        using Result = decltype(call(std::declval<FUNCTION>(), std::declval<ARGUMENTS>()...));
+        
+        /** True if FUNCTION can be called with ARGUMENTS. */
+        template <class FUNCTION, class... ARGUMENTS>
+        struct IsCallable
+        {
+            template <class CALLABLE, class = Result<CALLABLE,ARGUMENTS...> >
+            static std::true_type check (int);
+            
+            template <class CALLABLE>
+            static std::false_type check (...);
+            
+            static const bool value = decltype(check<FUNCTION>(0))::value;
+        };
+        
+        /** True if the first argument passed after a function is a stage ID string. That's only the case if
+            it converts to a string, and the function can't be called with all arguments including it. */
+        template <class FUNCTION, class... ARGUMENTS>
+        struct IsStageID : std::false_type {};
+        
+        template <class FUNCTION, class FIRST, class... REST>
+        struct IsStageID<FUNCTION,FIRST,REST...> : std::integral_constant<bool, std::is_convertible<FIRST,std::string>::value and (IsCallable<FUNCTION,FIRST,REST...>::value == false)> {};
+        
+    }; // end struct RCH::NanoInvoke
+    
+// ------------------------------------------------------------------------------------------
+// CLOCK BACKENDS
+// A clock backend provides raw integer ticks() and converts tick counts into nanoseconds().
+// Its prepare() is called whenever a timer is constructed, so any setup happens before timing.
+// Pass one as the CLOCK template argument of BasicNanoTimer to change where timestamps come from.
+    
+    /** Default clock backend, reads std::chrono::high_resolution_clock. */
+    struct NanoSystemClock
+    {
+        /** Nothing to set up for the system clock. */
+        static void prepare () {}
+        
+        /** Returns the current time in raw integer clock ticks. */
+        static const RCH_NANOTIMER_TICKS ticks ()
+        {
+            return static_cast<RCH_NANOTIMER_TICKS>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        }
+        
+        /** Converts a raw tick count into integer nanoseconds, without any floating point math. */
+        static const RCH_NANOTIMER_TICKS nanoseconds (const RCH_NANOTIMER_TICKS& Ticks)
+        {
+            typedef std::chrono::high_resolution_clock::duration ClockDuration;
+            
+            return static_cast<RCH_NANOTIMER_TICKS>(std::chrono::duration_cast<std::chrono::nanoseconds>(ClockDuration(Ticks)).count());
+        }
+        
+    }; // end struct RCH::NanoSystemClock
+    
+    /** Clock backend that reads the CPU's time stamp counter (TSC) directly.
+        Reading the TSC costs only a few nanoseconds, much less than a clock_gettime() call.
+        The tick rate is calibrated against std::chrono::steady_clock the first time it is
+        needed, see calibration(). On non-x86 platforms this falls back to steady_clock. */
+    struct NanoTscClock
+    {
+        /** Results of calibrating the TSC tick rate against std::chrono::steady_clock. */
+        struct Calibration
+        {
+            // How many nanoseconds pass per TSC tick
+            double nanosecondsPerTick = 1.0;
+            
+            // Relative uncertainty of nanosecondsPerTick, e.g. 0.000001 for 1 ppm
+            double error = 0.0;
+            
+            // True if the CPU reports an invariant TSC that ticks at a constant rate in all power states
+            bool invariant = false;
+            
+        }; // end struct Calibration
+        
+        /** Makes sure the tick rate is calibrated before any timer using this clock starts. */
+        static void prepare ()
+        {
+            calibration();
+        }
+        
+        /** Returns true if the TSC can actually be read on this platform. */
+        static const bool available ()
+        {
+            return (RCH_NANOTIMER_HAS_TSC == 1);
+        }
+        
+        /** Returns the current time in raw TSC ticks.
+            The lfence instructions keep the CPU from moving the read across surrounding code. */
+        static const RCH_NANOTIMER_TICKS ticks ()
+        {
+#if RCH_NANOTIMER_HAS_TSC
+            _mm_lfence();
+            const unsigned long long tsc = __rdtsc();
+            _mm_lfence();
+            
+            return static_cast<RCH_NANOTIMER_TICKS>(tsc);
+#else
+            return static_cast<RCH_NANOTIMER_TICKS>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+        
+        /** Converts a raw tick count into nanoseconds, using the calibrated tick rate. */
+        static const RCH_NANOTIMER_TICKS nanoseconds (const RCH_NANOTIMER_TICKS& Ticks)
+        {
+            return static_cast<RCH_NANOTIMER_TICKS>(std::llround(static_cast<double>(Ticks) * calibration().nanosecondsPerTick));
+        }
+        
+        /** Returns the calibration results. Calibration runs only once per process, when the
+            first timer using this clock is constructed (or on the first call to this), and takes about 50 ms. */
+        static const Calibration& calibration ()
+        {
+            static const Calibration result = calibrate();
+            
+            return result;
+        }
+        
+    private:
+        
+        // Returns true if the CPU advertises an invariant TSC (CPUID 0x80000007, EDX bit 8)
+        static const bool invariant ()
+        {
+#if RCH_NANOTIMER_HAS_TSC
+    #if defined(_MSC_VER)
+            int registers[4] = {0, 0, 0, 0};
+            __cpuid(registers, 0x80000007);
+            
+            return (registers[3] & (1 << 8)) != 0;
+    #else
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            
+            return (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0) and ((edx & (1 << 8)) != 0);
+    #endif
+#else
+            return false;
+#endif
+        }
+        
+        // Measures how many steady_clock nanoseconds pass per TSC tick over several rounds
+        static const Calibration calibrate ()
+        {
+            Calibration result;
+            
+            result.invariant = invariant();
+            
+            // Without a TSC, ticks() already returns nanoseconds
+            if (available() == false)
+            {
+                return result;
+            }
+            
+            std::vector<double> rounds;
+            
+            for (int round=0; round<RCH_NANOTIMER_TSC_CALIBRATION_ROUNDS; ++round)
+            {
+                const std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+                const RCH_NANOTIMER_TICKS tickStart = ticks();
+                
+                // Busy wait instead of sleeping, so the CPU doesn't drop into a power saving state
+                std::chrono::steady_clock::time_point clockStop = clockStart;
+                
+                while (clockStop - clockStart < std::chrono::nanoseconds(RCH_NANOTIMER_TSC_CALIBRATION_SPAN))
+                {
+                    clockStop = std::chrono::steady_clock::now();
+                }
+                
+                const RCH_NANOTIMER_TICKS tickStop = ticks();
+                
+                const double elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clockStop - clockStart).count());
+                
+                rounds.push_back(elapsed / static_cast<double>(tickStop - tickStart));
+            }
+            
+            // The median round is the tick rate, half the spread of all rounds is its uncertainty
+            std::sort(rounds.begin(), rounds.end());
+            
+            result.nanosecondsPerTick = rounds[rounds.size() / 2];
+            result.error = (rounds.back() - rounds.front()) / 2.0 / result.nanosecondsPerTick;
+            
+            return result;
+        }
+        
+    }; // end struct RCH::NanoTscClock
+    
+// ------------------------------------------------------------------------------------------
+// LATENCY HISTOGRAM
+// Counts values in log-linear buckets, like an HDR histogram: exact below a threshold, and above it
+// every power of two range is split into the same number of linear buckets. That keeps the relative
+// error of every value below a fixed bound, with a fixed amount of memory no matter how many values.
+    
+    /** Fixed memory latency histogram in integer nanoseconds, with O(1) recording.
+        Keep one per thread and merge() them for a combined view. Not thread safe by itself. */
+    class NanoHistogram
+    {
+    public:
+        
+        /** Creates an empty histogram that keeps Digits significant decimal digits of every value (1 to 5),
+            for values up to Highest nanoseconds. Larger values are counted as Highest. */
+        explicit NanoHistogram (const unsigned int& Digits=RCH_NANOTIMER_DEFAULT_HISTOGRAM_DIGITS, const std::uint64_t& Highest=RCH_NANOTIMER_DEFAULT_HISTOGRAM_HIGHEST)
+        {
+            // Find the smallest power of two sub-bucket count that resolves the requested digits
+            const double resolution = 2.0 * std::pow(10.0, static_cast<double>(std::min(std::max(Digits, 1u), 5u)));
+            
+            subBits = 1;
+            
+            while (static_cast<double>(1ULL << subBits) < resolution)
+            {
+                ++subBits;
+            }
+            
+            highest = std::max(Highest, static_cast<std::uint64_t>(1ULL << subBits));
+            
+            counts.assign(index(highest) + 1, 0);
+        }
+        
+        /** Counts a value Count times. */
+        void record (const std::uint64_t& Nanoseconds, const std::uint64_t& Count=1)
+        {
+            const std::uint64_t value = std::min(Nanoseconds, highest);
+            
+            counts[index(value)] += Count;
+            
+            minimumValue = (total == 0) ? value : std::min(minimumValue, value);
+            maximumValue = std::max(maximumValue, value);
+            
+            total += Count;
+            sum += static_cast<double>(value) * static_cast<double>(Count);
+        }
+        
+        /** Adds all values of another histogram to this one. Histograms with different settings can be
+            merged too, their values are then re-bucketed at this histogram's resolution. */
+        void merge (const NanoHistogram& Other)
+        {
+            if (Other.total == 0)
+            {
+                return;
+            }
+            
+            if ((Other.subBits == subBits) and (Other.highest == highest))
+            {
+                for (unsigned int item=0; item<counts.size(); ++item)
+                {
+                    counts[item] += Other.counts[item];
+                }
+                
+                minimumValue = (total == 0) ? Other.minimumValue : std::min(minimumValue, Other.minimumValue);
+                maximumValue = std::max(maximumValue, Other.maximumValue);
+                
+                total += Other.total;
+                sum += Other.sum;
+                
+                return;
+            }
+            
+            for (unsigned int item=0; item<Other.counts.size(); ++item)
+            {
+                if (Other.counts[item] > 0)
+                {
+                    record(std::min(Other.highestEquivalent(item), Other.maximumValue), Other.counts[item]);
+                }
+            }
+        }
+        
+        /** Removes all counted values, but keeps the histogram's settings and memory. */
+        void reset ()
+        {
+            std::fill(counts.begin(), counts.end(), 0);
+            
+            total = 0;
+            sum = 0;
+            minimumValue = 0;
+            maximumValue = 0;
+        }
+        
+        /** Returns the value that Percent percent (0 to 100) of all counted values are at or below.
+            The result is accurate to the histogram's significant digits. */
+        const std::uint64_t percentile (const double& Percent) const
+        {
+            if (total == 0)
+            {
+                return 0;
+            }
+            
+            if (Percent <= 0.0)
+            {
+                return minimumValue;
+            }
+            
+            // The rank of the value we're looking for, counting from 1
+            const std::uint64_t rank = std::max(static_cast<std::uint64_t>(1), static_cast<std::uint64_t>(std::ceil(std::min(Percent, 100.0) / 100.0 * static_cast<double>(total))));
+            
+            std::uint64_t seen = 0;
+            
+            for (unsigned int item=0; item<counts.size(); ++item)
+            {
+                seen += counts[item];
+                
+                if (seen >= rank)
+                {
+                    return std::max(minimumValue, std::min(highestEquivalent(item), maximumValue));
+                }
+            }
+            
+            return maximumValue;
+        }
+        
+        /** Returns the number of counted values. */
+        const std::uint64_t count () const
+        {
+            return total;
+        }
+        
+        /** Returns the smallest and largest counted value, exact. */
+        const std::uint64_t minimum () const
+        {
+            return minimumValue;
+        }
+        
+        const std::uint64_t maximum () const
+        {
+            return maximumValue;
+        }
+        
+        /** Returns the arithmetic mean of all counted values, exact. */
+        const double mean () const
+        {
+            return (total > 0) ? sum / static_cast<double>(total) : 0.0;
+        }
+        
+    private:
+        
+        // Bucket index of a value. Values below 2^subBits get one bucket each, above that
+        // every power of two range gets 2^(subBits-1) buckets.
+        const unsigned int index (const std::uint64_t& Value) const
+        {
+            if (Value < (1ULL << subBits))
+            {
+                return static_cast<unsigned int>(Value);
+            }
+            
+            const unsigned int shift = highestBit(Value) - (subBits - 1);
+            
+            return static_cast<unsigned int>((static_cast<std::uint64_t>(shift) << (subBits - 1)) + (Value >> shift));
+        }
+        
+        // Largest value that lands in the same bucket as the given bucket index
+        const std::uint64_t highestEquivalent (const unsigned int& Index) const
+        {
+            if (Index < (1u << subBits))
+            {
+                return Index;
+            }
+            
+            const unsigned int shift = (Index >> (subBits - 1)) - 1;
+            const std::uint64_t lowest = (static_cast<std::uint64_t>(Index) - (static_cast<std::uint64_t>(shift) << (subBits - 1))) << shift;
+            
+            return lowest + (1ULL << shift) - 1;
+        }
+        
+        // Position of the highest set bit of a non-zero value
+        static const unsigned int highestBit (const std::uint64_t& Value)
+        {
+#if defined(__GNUC__) or defined(__clang__)
+            return 63 - static_cast<unsigned int>(__builtin_clzll(Value));
+#elif defined(_MSC_VER) and defined(_M_X64)
+            unsigned long position;
+            _BitScanReverse64(&position, Value);
+            return static_cast<unsigned int>(position);
+#else
+            unsigned int position = 0;
+            
+            for (std::uint64_t remaining=Value; remaining>1; remaining>>=1)
+            {
+                ++position;
+            }
+            
+            return position;
+#endif
+        }
+        
+        // Number of bits in the linear part of every bucket range
+        unsigned int subBits;
+        
+        // Largest trackable value
+        std::uint64_t highest;
+        
+        std::vector<std::uint64_t> counts;
+        
+        std::uint64_t total = 0;
+        double sum = 0;
+        std::uint64_t minimumValue = 0;
+        std::uint64_t maximumValue = 0;
+        
+    }; // end class RCH::NanoHistogram
+    
+// ------------------------------------------------------------------------------------------
+// SAMPLE COMPARISON
+// Two sets of timings practically never have the same average, so the question is whether they differ
+// by more than noise. The Mann-Whitney U test answers that without assuming any distribution, which
+// suits timings with their long tails, and bootstrapping gives a confidence interval for the change.
+    
+    /** What a comparison concluded about the current samples, relative to the baseline. */
+    enum class NanoVerdict
+    {
+        noise,
+        improved,
+        regressed
+    };
+    
+    /** Compares two sets of timing samples, a baseline and the current one, e.g. two benchmark stages,
+        or a saved baseline run and today's run. Lower values are better. Samples can be in any unit,
+        as long as both sets use the same one. */
+    class NanoComparison
+    {
+    public:
+        
+        /** Compares Current against Baseline. The verdict is only improved or regressed if the Mann-Whitney
+            p-value is below Significance, the bootstrapped confidence interval of the change doesn't
+            include zero, and the median changed by at least Threshold (e.g. 0.02 for 2%). The confidence
+            interval's level is one minus Significance, from Resamples bootstrap resamples of both sets. */
+        NanoComparison (const std::vector<double>& Baseline, const std::vector<double>& Current, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES)
+        {
+            if ((Baseline.empty() == true) or (Current.empty() == true))
+            {
+                return;
+            }
+            
+            baselineMedian = median(Baseline);
+            currentMedian = median(Current);
+            
+            if (baselineMedian <= 0.0)
+            {
+                return;
+            }
+            
+            relativeChange = currentMedian / baselineMedian - 1.0;
+            probability = mannWhitney(Baseline, Current);
+            
+            bootstrap(Baseline, Current, Significance, Resamples);
+            
+            const bool significant = (probability < Significance) and ((lowerBound > 0.0) or (upperBound < 0.0));
+            
+            if ((significant == true) and (relativeChange >= Threshold))
+            {
+                result = NanoVerdict::regressed;
+            }
+            else if ((significant == true) and (relativeChange <= -Threshold))
+            {
+                result = NanoVerdict::improved;
+            }
+        }
+        
+        /** Returns the relative change of the median, e.g. 0.1 if the current samples are 10% slower. */
+        const double change () const
+        {
+            return relativeChange;
+        }
+        
+        /** Returns the lower end of the confidence interval of change(). */
+        const double lower () const
+        {
+            return lowerBound;
+        }
+        
+        /** Returns the upper end of the confidence interval of change(). */
+        const double upper () const
+        {
+            return upperBound;
+        }
+        
+        /** Returns the two sided Mann-Whitney U test p-value, the chance that differences at least this
+            large would show up between two sets of samples of the same thing. */
+        const double p () const
+        {
+            return probability;
+        }
+        
+        /** Returns the medians of the baseline and the current samples. */
+        const double baseline () const
+        {
+            return baselineMedian;
+        }
+        
+        const double current () const
+        {
+            return currentMedian;
+        }
+        
+        /** Returns whether the current samples improved, regressed, or only differ by noise. */
+        const NanoVerdict verdict () const
+        {
+            return result;
+        }
+        
+        /** Returns true only if the current samples are significantly slower, for use in performance gates. */
+        const bool regressed () const
+        {
+            return (result == NanoVerdict::regressed);
+        }
+        
+        /** Returns the verdict as text: "improved", "regressed" or "noise". */
+        const std::string describe () const
+        {
+            return (result == NanoVerdict::improved) ? "improved" : (result == NanoVerdict::regressed) ? "regressed" : "noise";
+        }
+        
+    private:
+        
+        // Returns the median of some values, which are copied because selecting reorders them
+        static const double median (std::vector<double> Values)
+        {
+            const size_t middle = Values.size() / 2;
+            
+            std::nth_element(Values.begin(), Values.begin() + middle, Values.end());
+            
+            const double upperMiddle = Values[middle];
+            
+            if ((Values.size() % 2) == 1)
+            {
+                return upperMiddle;
+            }
+            
+            // For an even count, the lower middle value is the largest value below the upper middle
+            return 0.5 * (upperMiddle + *std::max_element(Values.begin(), Values.begin() + middle));
+        }
+        
+        // Returns the two sided p-value of the Mann-Whitney U test, through the normal approximation
+        // with tie correction, which is accurate enough for the sample counts benchmarks produce
+        static const double mannWhitney (const std::vector<double>& Baseline, const std::vector<double>& Current)
+        {
+            // Rank both sets together, remembering which set every value came from
+            std::vector<std::pair<double,bool> > values;
+            values.reserve(Baseline.size() + Current.size());
+            
+            for (size_t item=0; item<Baseline.size(); ++item)
+            {
+                values.push_back(std::make_pair(Baseline[item], true));
+            }
+            
+            for (size_t item=0; item<Current.size(); ++item)
+            {
+                values.push_back(std::make_pair(Current[item], false));
+            }
+            
+            std::sort(values.begin(), values.end());
+            
+            const double total = static_cast<double>(values.size());
+            double rankSum = 0.0;
+            double ties = 0.0;
+            
+            for (size_t first=0; first<values.size(); )
+            {
+                // Tied values all get the average of their ranks
+                size_t last = first + 1;
+                
+                while ((last < values.size()) and (values[last].first == values[first].first))
+                {
+                    ++last;
+                }
+                
+                const double rank = 0.5 * static_cast<double>(first + last + 1);
+                const double count = static_cast<double>(last - first);
+                
+                for (size_t item=first; item<last; ++item)
+                {
+                    rankSum += (values[item].second == true) ? rank : 0.0;
+                }
+                
+                ties += count * count * count - count;
+                first = last;
+            }
+            
+            const double baselineCount = static_cast<double>(Baseline.size());
+            const double currentCount = static_cast<double>(Current.size());
+            
+            const double u = rankSum - baselineCount * (baselineCount + 1.0) / 2.0;
+            const double mean = baselineCount * currentCount / 2.0;
+            const double variance = baselineCount * currentCount / 12.0 * ((total + 1.0) - ties / (total * (total - 1.0)));
+            
+            // All values are equal, so there's no difference at all
+            if (variance <= 0.0)
+            {
+                return 1.0;
+            }
+            
+            // With continuity correction
+            const double z = std::max(0.0, std::fabs(u - mean) - 0.5) / std::sqrt(variance);
+            
+            return std::erfc(z / std::sqrt(2.0));
+        }
+        
+        // Finds the confidence interval of the relative median change by resampling both sets with replacement.
+        // The random generator has a fixed seed, so comparing the same samples always gives the same interval.
+        void bootstrap (const std::vector<double>& Baseline, const std::vector<double>& Current, const double& Significance, const unsigned int& Resamples)
+        {
+            lowerBound = upperBound = relativeChange;
+            
+            if (Resamples == 0)
+            {
+                return;
+            }
+            
+            std::mt19937_64 generator (0x5EED);
+            
+            std::uniform_int_distribution<size_t> pickBaseline (0, Baseline.size() - 1);
+            std::uniform_int_distribution<size_t> pickCurrent (0, Current.size() - 1);
+            
+            std::vector<double> baselineResample (Baseline.size());
+            std::vector<double> currentResample (Current.size());
+            std::vector<double> changes;
+            
+            for (unsigned int resample=0; resample<Resamples; ++resample)
+            {
+                for (size_t item=0; item<baselineResample.size(); ++item)
+                {
+                    baselineResample[item] = Baseline[pickBaseline(generator)];
+                }
+                
+                for (size_t item=0; item<currentResample.size(); ++item)
+                {
+                    currentResample[item] = Current[pickCurrent(generator)];
+                }
+                
+                const double resampledBaseline = median(baselineResample);
+                
+                if (resampledBaseline > 0.0)
+                {
+                    changes.push_back(median(currentResample) / resampledBaseline - 1.0);
+                }
+            }
+            
+            if (changes.empty() == true)
+            {
+                return;
+            }
+            
+            std::sort(changes.begin(), changes.end());
+            
+            const double tail = 0.5 * std::min(std::max(Significance, 0.0), 1.0) * static_cast<double>(changes.size() - 1);
+            
+            lowerBound = changes[static_cast<size_t>(tail)];
+            upperBound = changes[changes.size() - 1 - static_cast<size_t>(tail)];
+        }
+        
+        double baselineMedian = 0.0;
+        double currentMedian = 0.0;
+        double relativeChange = 0.0;
+        double lowerBound = 0.0;
+        double upperBound = 0.0;
+        double probability = 1.0;
+        NanoVerdict result = NanoVerdict::noise;
+        
+    }; // end class RCH::NanoComparison
+    
+// ------------------------------------------------------------------------------------------
+// BASELINES
+// A baseline file keeps the samples of named benchmarks across runs, so every build can be checked
+// against an earlier one. It starts with a fixed size header and the machine name, followed by every
+// benchmark's name and its per-call samples in nanoseconds, as raw doubles in the writer's byte order.
+    
+    struct NanoBaselineHeader
+    {
+        char magic[8] = {'R','C','H','N','A','N','O','B'};
+        std::uint32_t version = 1;
+        std::uint32_t endian = 0x01020304;
+        
+        // Clock calibration of the timer that took the samples, nanoseconds per raw tick
+        double nanosecondsPerTick = 0.0;
+        
+        // When the baseline was created, in seconds since the Unix epoch
+        std::uint64_t created = 0;
+        
+        // Number of hardware threads of the machine, number of benchmarks, and length of the machine name
+        std::uint32_t cpus = 0;
+        std::uint32_t benchmarks = 0;
+        std::uint32_t machineLength = 0;
+        
+        std::uint32_t reserved[5] = {};
+        
+    }; // end struct RCH::NanoBaselineHeader
+    
+    /** Named sets of benchmark samples plus information about the machine that took them, which
+        can be saved to a file and loaded back later, see BasicNanoTimer::record() and check(). */
+    class NanoBaseline
+    {
+    public:
+        
+        /** Creates an empty baseline, stamped with this machine's name, hardware thread count and the current time. */
+        NanoBaseline ()
+        {
+            header.created = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+            header.cpus = std::thread::hardware_concurrency();
+            
+            char name [256] = {};
+            
+#if defined(_WIN32)
+            DWORD length = sizeof(name);
+            
+            if (GetComputerNameA(name, &length) != 0)
+            {
+                machineName.assign(name, length);
+            }
+#else
+            if (gethostname(name, sizeof(name) - 1) == 0)
+            {
+                machineName = name;
+            }
+#endif
+        }
+        
+        /** Adds the per-call samples of a benchmark in nanoseconds, replacing any earlier samples with the same Name. */
+        void add (const std::string& Name, const std::vector<double>& Nanoseconds)
+        {
+            for (unsigned int item=0; item<benchmarks.size(); ++item)
+            {
+                if (benchmarks[item].first == Name)
+                {
+                    benchmarks[item].second = Nanoseconds;
+                    
+                    return;
+                }
+            }
+            
+            benchmarks.push_back(std::make_pair(Name, Nanoseconds));
+        }
+        
+        /** Returns the samples of a benchmark in nanoseconds, empty if there is no benchmark with that Name. */
+        const std::vector<double> samples (const std::string& Name) const
+        {
+            for (unsigned int item=0; item<benchmarks.size(); ++item)
+            {
+                if (benchmarks[item].first == Name)
+                {
+                    return benchmarks[item].second;
+                }
+            }
+            
+            return std::vector<double>();
+        }
+        
+        /** Returns the names of all benchmarks, in the order they were added. */
+        const std::vector<std::string> names () const
+        {
+            std::vector<std::string> result;
+            
+            for (unsigned int item=0; item<benchmarks.size(); ++item)
+            {
+                result.push_back(benchmarks[item].first);
+            }
+            
+            return result;
+        }
+        
+        /** Sets the clock calibration of the timer that took the samples, in nanoseconds per raw tick. */
+        void calibration (const double& NanosecondsPerTick)
+        {
+            header.nanosecondsPerTick = NanosecondsPerTick;
+        }
+        
+        /** Returns the clock calibration of the timer that took the samples, in nanoseconds per raw tick. */
+        const double nanosecondsPerTick () const
+        {
+            return header.nanosecondsPerTick;
+        }
+        
+        /** Returns the name of the machine the samples were taken on. */
+        const std::string machine () const
+        {
+            return machineName;
+        }
+        
+        /** Returns the number of hardware threads of the machine the samples were taken on. */
+        const unsigned int cpus () const
+        {
+            return header.cpus;
+        }
+        
+        /** Returns when the baseline was created, in seconds since the Unix epoch. */
+        const std::uint64_t created () const
+        {
+            return header.created;
+        }
+        
+        /** Writes the baseline to a file in one go. It's written to a temporary file first and then renamed,
+            so an interrupted write never leaves a broken baseline behind. Returns false if that failed. */
+        const bool save (const std::string& Path) const
+        {
+            NanoBaselineHeader fileHeader (header);
+            fileHeader.benchmarks = static_cast<std::uint32_t>(benchmarks.size());
+            fileHeader.machineLength = static_cast<std::uint32_t>(machineName.size());
+            
+            // Assemble the whole file in memory, so it takes a single write
+            std::string bytes (reinterpret_cast<const char*>(&fileHeader), sizeof(NanoBaselineHeader));
+            bytes += machineName;
+            
+            for (unsigned int item=0; item<benchmarks.size(); ++item)
+            {
+                const std::uint32_t nameLength = static_cast<std::uint32_t>(benchmarks[item].first.size());
+                const std::uint64_t count = benchmarks[item].second.size();
+                
+                bytes.append(reinterpret_cast<const char*>(&nameLength), sizeof(std::uint32_t));
+                bytes += benchmarks[item].first;
+                bytes.append(reinterpret_cast<const char*>(&count), sizeof(std::uint64_t));
+                
+                if (count > 0)
+                {
+                    bytes.append(reinterpret_cast<const char*>(benchmarks[item].second.data()), count * sizeof(double));
+                }
+            }
+            
+            const std::string temporary = Path + ".tmp";
+            
+            std::FILE* file = std::fopen(temporary.c_str(), "wb");
+            
+            if (file == nullptr)
+            {
+                return false;
+            }
+            
+            const bool written = (std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+            
+            if ((std::fclose(file) != 0) or (written == false))
+            {
+                std::remove(temporary.c_str());
+                
+                return false;
+            }
+            
+#if defined(_WIN32)
+            // Windows doesn't rename onto existing files
+            std::remove(Path.c_str());
+#endif
+            
+            return (std::rename(temporary.c_str(), Path.c_str()) == 0);
+        }
+        
+        /** Replaces this baseline with one loaded from a file. Returns false if the file can't be read or
+            isn't a valid baseline file from a machine with the same byte order, the baseline is empty then. */
+        const bool load (const std::string& Path)
+        {
+            header = NanoBaselineHeader();
+            machineName.clear();
+            benchmarks.clear();
+            
+            std::FILE* file = std::fopen(Path.c_str(), "rb");
+            
+            if (file == nullptr)
+            {
+                return false;
+            }
+            
+            std::string bytes;
+            char chunk [65536];
+            size_t read = 0;
+            
+            while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            {
+                bytes.append(chunk, read);
+            }
+            
+            std::fclose(file);
+            
+            const NanoBaselineHeader expected;
+            
+            if (bytes.size() < sizeof(NanoBaselineHeader))
+            {
+                return false;
+            }
+            
+            std::memcpy(&header, bytes.data(), sizeof(NanoBaselineHeader));
+            
+            if ((std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0) or (header.version != expected.version) or (header.endian != expected.endian))
+            {
+                header = NanoBaselineHeader();
+                
+                return false;
+            }
+            
+            size_t position = sizeof(NanoBaselineHeader);
+            
+            bool valid = take(bytes, position, header.machineLength, machineName);
+            
+            for (std::uint32_t item=0; (item<header.benchmarks) and (valid == true); ++item)
+            {
+                std::uint32_t nameLength = 0;
+                std::uint64_t count = 0;
+                std::string name;
+                
+                valid = take(bytes, position, nameLength) and take(bytes, position, nameLength, name) and take(bytes, position, count)
+                    and (count <= (bytes.size() - position) / sizeof(double));
+                
+                if (valid == true)
+                {
+                    std::vector<double> samples (static_cast<size_t>(count));
+                    
+                    for (size_t sample=0; sample<samples.size(); ++sample)
+                    {
+                        take(bytes, position, samples[sample]);
+                    }
+                    
+                    benchmarks.push_back(std::make_pair(name, samples));
+                }
+            }
+            
+            if (valid == false)
+            {
+                header = NanoBaselineHeader();
+                machineName.clear();
+                benchmarks.clear();
+            }
+            
+            return valid;
+        }
+        
+        /** Compares the samples of one benchmark in this baseline with the same benchmark in Current, see NanoComparison.
+            If either one doesn't have that benchmark, the verdict is noise. */
+        const NanoComparison compare (const NanoBaseline& Current, const std::string& Name, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES) const
+        {
+            return NanoComparison(samples(Name), Current.samples(Name), Significance, Threshold, Resamples);
+        }
+        
+        /** Compares every benchmark of this baseline with the same benchmark in Current, and returns how many
+            of them regressed. Zero means the check passed. Benchmarks that only one of them has are skipped. */
+        const unsigned int check (const NanoBaseline& Current, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES) const
+        {
+            unsigned int regressions = 0;
+            
+            for (unsigned int item=0; item<benchmarks.size(); ++item)
+            {
+                regressions += compare(Current, benchmarks[item].first, Significance, Threshold, Resamples).regressed();
+            }
+            
+            return regressions;
+        }
+        
+    private:
+        
+        // Copies Length bytes from Position on into Target and moves Position past them, false if the file is too short
+        static const bool take (const std::string& Bytes, size_t& Position, const std::uint64_t& Length, std::string& Target)
+        {
+            if (Length > Bytes.size() - Position)
+            {
+                return false;
+            }
+            
+            Target.assign(Bytes, Position, static_cast<size_t>(Length));
+            Position += static_cast<size_t>(Length);
+            
+            return true;
+        }
+        
+        // Copies one number from Position on into Target and moves Position past it, false if the file is too short
+        template <typename VALUE>
+        static const bool take (const std::string& Bytes, size_t& Position, VALUE& Target)
+        {
+            if (sizeof(VALUE) > Bytes.size() - Position)
+            {
+                return false;
+            }
+            
+            std::memcpy(&Target, Bytes.data() + Position, sizeof(VALUE));
+            Position += sizeof(VALUE);
+            
+            return true;
+        }
+        
+        NanoBaselineHeader header;
+        std::string machineName;
+        
+        // Every benchmark's name and per-call samples in nanoseconds
+        std::vector<std::pair<std::string,std::vector<double> > > benchmarks;
+        
+    }; // end class RCH::NanoBaseline
+    
+// ------------------------------------------------------------------------------------------
+// BINARY TRACE FILES
+// A trace file starts with a fixed size header, followed by all records and then the label table.
+// Every record is three LEB128 varints: the zigzag encoded tick difference to the previous record,
+// the label handle plus one (zero for unlabelled), and the thread ID. Numbers are stored in the
+// writing machine's byte order, the header's endian marker lets readers reject foreign files.
+    
+    /** Fixed size header at the start of every binary trace file. */
+    struct NanoTraceHeader
+    {
+        char magic[8] = {'R','C','H','N','A','N','O','T'};
+        std::uint32_t version = 1;
+        std::uint32_t endian = 0x01020304;
+        
+        // Clock calibration, multiply raw ticks with this to get nanoseconds
+        double nanosecondsPerTick = 0.0;
+        
+        // Number of records, and how many bytes they take up right after the header
+        std::uint64_t records = 0;
+        std::uint64_t recordBytes = 0;
+        
+        // Where the label table starts in the file, and how many labels it holds
+        std::uint64_t labelOffset = 0;
+        std::uint64_t labelCount = 0;
+        
+        std::uint64_t reserved = 0;
+        
+    }; // end struct RCH::NanoTraceHeader
+    
+    /** Streams split time events into a binary trace file, see BasicNanoTimer::write().
+        Records are encoded into a large buffer and written out in big sequential chunks. */
+    class NanoTraceWriter
+    {
+    public:
+        
+        NanoTraceWriter () {}
+        
+        ~NanoTraceWriter ()
+        {
+            close();
+        }
+        
+        /** Creates (or overwrites) a trace file, returns false if it can't be opened. */
+        const bool open (const std::string& Path)
+        {
+            close();
+            
+            file = std::fopen(Path.c_str(), "wb");
+            
+            if (file == nullptr)
+            {
+                return false;
+            }
+            
+            header = NanoTraceHeader();
+            previous = 0;
+            failed = false;
+            names.clear();
+            
+            buffer.clear();
+            buffer.reserve(RCH_NANOTIMER_TRACE_BUFFER + 32);
+            
+            // Reserve room for the header, it's written for real once all records are known
+            failed = (std::fwrite(&header, sizeof(NanoTraceHeader), 1, file) != 1);
+            
+            return (failed == false);
+        }
+        
+        /** Returns true while a trace file is open for writing. */
+        const bool isOpen () const
+        {
+            return (file != nullptr);
+        }
+        
+        /** Sets the clock calibration that's stored in the header, in nanoseconds per raw tick. */
+        void calibration (const double& NanosecondsPerTick)
+        {
+            header.nanosecondsPerTick = NanosecondsPerTick;
+        }
+        
+        /** Appends one record. Label is a label handle, or 0xFFFFFFFF for unlabelled events. */
+        void record (const std::int64_t& Ticks, const unsigned int& Label, const unsigned int& Thread)
+        {
+            const std::int64_t delta = Ticks - previous;
+            
+            // Zigzag encoding keeps small negative deltas small, in case records are out of order
+            varint((static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+            varint((Label == RCH_NANOTIMER_UNLABELLED) ? 0 : static_cast<std::uint64_t>(Label) + 1);
+            varint(Thread);
+            
+            previous = Ticks;
+            
+            ++header.records;
+            
+            if (buffer.size() >= RCH_NANOTIMER_TRACE_BUFFER)
+            {
+                flush();
+            }
+        }
+        
+        /** Sets the label table, where the name of every label handle is at its index. */
+        void labels (const std::vector<std::string>& Names)
+        {
+            names = Names;
+        }
+        
+        /** Writes the label table and the final header, then closes the file.
+            Returns false if anything could not be written. */
+        const bool close ()
+        {
+            if (file == nullptr)
+            {
+                return false;
+            }
+            
+            flush();
+            
+            header.labelOffset = sizeof(NanoTraceHeader) + header.recordBytes;
+            header.labelCount = names.size();
+            
+            for (unsigned int item=0; item<names.size(); ++item)
+            {
+                varint(names[item].size());
+                buffer.insert(buffer.end(), names[item].begin(), names[item].end());
+            }
+            
+            // The label table doesn't count as record bytes
+            const std::uint64_t recordBytes = header.recordBytes;
+            flush();
+            header.recordBytes = recordBytes;
+            
+            if ((std::fseek(file, 0, SEEK_SET) != 0) or (std::fwrite(&header, sizeof(NanoTraceHeader), 1, file) != 1))
+            {
+                failed = true;
+            }
+            
+            if (std::fclose(file) != 0)
+            {
+                failed = true;
+            }
+            
+            file = nullptr;
+            
+            return (failed == false);
+        }
+        
+    private:
+        
+        NanoTraceWriter (const NanoTraceWriter&) = delete;
+        NanoTraceWriter& operator= (const NanoTraceWriter&) = delete;
+        
+        // Appends an unsigned LEB128 varint, 7 bits per byte with the high bit set on all but the last
+        void varint (std::uint64_t Value)
+        {
+            while (Value >= 0x80)
+            {
+                buffer.push_back(static_cast<unsigned char>(Value | 0x80));
+                Value >>= 7;
+            }
+            
+            buffer.push_back(static_cast<unsigned char>(Value));
+        }
+        
+        // Hands all buffered bytes to the file in one write
+        void flush ()
+        {
+            if (buffer.empty() == false)
+            {
+                if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+                {
+                    failed = true;
+                }
+                
+                header.recordBytes += buffer.size();
+                buffer.clear();
+            }
+        }
+        
+        std::FILE* file = nullptr;
+        std::vector<unsigned char> buffer;
+        
+        NanoTraceHeader header;
+        std::vector<std::string> names;
+        
+        // Ticks of the last written record, the next record is stored relative to it
+        std::int64_t previous = 0;
+        
+        bool failed = false;
+        
+    }; // end class RCH::NanoTraceWriter
+    
+    /** Reads a binary trace file by mapping it into memory. Records are decoded one by one while
+        iterating, so even huge traces are never loaded or parsed as a whole. */
+    class NanoTraceReader
+    {
+    public:
+        
+        /** One decoded record. */
+        struct Record
+        {
+            // Raw clock ticks, multiply with nanosecondsPerTick() to get nanoseconds
+            std::int64_t ticks = 0;
+            
+            // Label handle, index into labels(), or 0xFFFFFFFF for unlabelled events
+            unsigned int label = RCH_NANOTIMER_UNLABELLED;
+            
+            unsigned int thread = 0;
+            
+        }; // end struct Record
+        
+        /** Forward iterator that decodes the next record whenever it's advanced. */
+        class Iterator
+        {
+        public:
+            
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Record value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Record* pointer;
+            typedef const Record& reference;
+            
+            Iterator (const unsigned char* Position, const unsigned char* End, const std::uint64_t& Remaining) : position(Position), end(End), remaining(Remaining)
+            {
+                decode();
+            }
+            
+            const Record& operator* () const { return current; }
+            const Record* operator-> () const { return &current; }
+            
+            Iterator& operator++ ()
+            {
+                --remaining;
+                decode();
+                
+                return *this;
+            }
+            
+            Iterator operator++ (int) { Iterator previous (*this); ++(*this); return previous; }
+            
+            bool operator== (const Iterator& Other) const { return remaining == Other.remaining; }
+            bool operator!= (const Iterator& Other) const { return remaining != Other.remaining; }
+            
+        private:
+            
+            // Reads the record at the current position, ends the iteration early if the data is cut off
+            void decode ()
+            {
+                if (remaining == 0)
+                {
+                    return;
+                }
+                
+                std::uint64_t delta, label, thread;
+                
+                if ((varint(delta) == false) or (varint(label) == false) or (varint(thread) == false))
+                {
+                    remaining = 0;
+                    return;
+                }
+                
+                current.ticks += static_cast<std::int64_t>((delta >> 1) ^ (~(delta & 1) + 1));
+                current.label = (label == 0) ? RCH_NANOTIMER_UNLABELLED : static_cast<unsigned int>(label - 1);
+                current.thread = static_cast<unsigned int>(thread);
+            }
+            
+            const bool varint (std::uint64_t& Value)
+            {
+                Value = 0;
+                
+                for (unsigned int shift=0; (position < end) and (shift < 64); shift+=7)
+                {
+                    const unsigned char byte = *position++;
+                    
+                    Value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    
+                    if ((byte & 0x80) == 0)
+                    {
+                        return true;
+                    }
+                }
+                
+                return false;
+            }
+            
+            const unsigned char* position;
+            const unsigned char* end;
+            std::uint64_t remaining;
+            
+            Record current;
+            
+        }; // end class Iterator
+        
+        /** Maps a trace file into memory. Check valid() before reading. */
+        explicit NanoTraceReader (const std::string& Path)
+        {
+            if (map(Path) == false)
+            {
+                return;
+            }
+            
+            std::memcpy(&header, data, sizeof(NanoTraceHeader));
+            
+            const NanoTraceHeader expected;
+            
+            // Only accept files from this format version with this machine's byte order,
+            // whose sections actually fit into the file
+            if ((std::memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0) or (header.version != expected.version) or (header.endian != expected.endian) or (header.recordBytes > bytes - sizeof(NanoTraceHeader)) or (header.labelOffset > bytes))
+            {
+                return;
+            }
+            
+            // The label table is small, so it's the only part that's parsed up front
+            const unsigned char* position = data + header.labelOffset;
+            const unsigned char* end = data + bytes;
+            
+            for (std::uint64_t item=0; item<header.labelCount; ++item)
+            {
+                std::uint64_t length = 0;
+                unsigned int shift = 0;
+                
+                while ((position < end) and (shift < 64))
+                {
+                    const unsigned char byte = *position++;
+                    
+                    length |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                    
+                    if ((byte & 0x80) == 0)
+                    {
+                        break;
+                    }
+                }
+                
+                if (length > static_cast<std::uint64_t>(end - position))
+                {
+                    return;
+                }
+                
+                names.push_back(std::string(reinterpret_cast<const char*>(position), static_cast<std::size_t>(length)));
+                position += length;
+            }
+            
+            valid = true;
+        }
+        
+        ~NanoTraceReader ()
+        {
+            unmap();
+        }
+        
+        /** Returns true if the file was mapped and has a valid header and label table. */
+        const bool isValid () const
+        {
+            return valid;
+        }
+        
+        /** Returns the number of records in the file. */
+        const std::uint64_t size () const
+        {
+            return (valid == true) ? header.records : 0;
+        }
+        
+        /** Returns the clock calibration the file was written with. */
+        const double nanosecondsPerTick () const
+        {
+            return header.nanosecondsPerTick;
+        }
+        
+        /** Returns the label table, the name of every label handle is at its index. */
+        const std::vector<std::string>& labels () const
+        {
+            return names;
+        }
+        
+        Iterator begin () const
+        {
+            if (valid == false)
+            {
+                return end();
+            }
+            
+            const unsigned char* records = data + sizeof(NanoTraceHeader);
+            
+            return Iterator(records, records + header.recordBytes, size());
+        }
+        
+        Iterator end () const
+        {
+            return Iterator(nullptr, nullptr, 0);
+        }
+        
+    private:
+        
+        NanoTraceReader (const NanoTraceReader&) = delete;
+        NanoTraceReader& operator= (const NanoTraceReader&) = delete;
+        
+        // Maps the whole file read-only, returns false if that didn't work or the file is too small
+        const bool map (const std::string& Path)
+        {
+#if defined(_WIN32)
+            file = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            
+            LARGE_INTEGER fileSize;
+            
+            if ((file == INVALID_HANDLE_VALUE) or (GetFileSizeEx(file, &fileSize) == 0) or (fileSize.QuadPart < static_cast<LONGLONG>(sizeof(NanoTraceHeader))))
+            {
+                return false;
+            }
+            
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            
+            if (mapping == nullptr)
+            {
+                return false;
+            }
+            
+            data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            bytes = static_cast<std::uint64_t>(fileSize.QuadPart);
+#else
+            file = ::open(Path.c_str(), O_RDONLY);
+            
+            struct stat status;
+            
+            if ((file < 0) or (fstat(file, &status) != 0) or (status.st_size < static_cast<off_t>(sizeof(NanoTraceHeader))))
+            {
+                return false;
+            }
+            
+            void* address = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            
+            if (address == MAP_FAILED)
+            {
+                return false;
+            }
+            
+            // Records are read front to back
+            madvise(address, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+            
+            data = static_cast<const unsigned char*>(address);
+            bytes = static_cast<std::uint64_t>(status.st_size);
+#endif
+            return (data != nullptr);
+        }
+        
+        void unmap ()
+        {
+#if defined(_WIN32)
+            if (data != nullptr)
+            {
+                UnmapViewOfFile(data);
+            }
+            
+            if (mapping != nullptr)
+            {
+                CloseHandle(mapping);
+            }
+            
+            if (file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(file);
+            }
+#else
+            if (data != nullptr)
+            {
+                munmap(const_cast<unsigned char*>(data), static_cast<std::size_t>(bytes));
+            }
+            
+            if (file >= 0)
+            {
+                ::close(file);
+            }
+#endif
+        }
+        
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int file = -1;
+#endif
+        
+        const unsigned char* data = nullptr;
+        std::uint64_t bytes = 0;
+        
+        NanoTraceHeader header;
+        std::vector<std::string> names;
+        
+        bool valid = false;
+        
+    }; // end class RCH::NanoTraceReader
+    
+// ------------------------------------------------------------------------------------------
+// PARAMETER RANGES
+// Benchmark suites run every benchmark for every combination of parameter values, see BasicNanoTimer::NanoSuite.
+// A range is just a list of values, these helpers build the common ones. Custom lists work the same: {1, 3, 7}
+    
+    struct NanoRange
+    {
+        /** Returns From, From + Step, From + 2 * Step and so on, up to and including To. */
+        static const std::vector<long long> linear (const long long& From, const long long& To, const long long& Step=1)
+        {
+            std::vector<long long> values;
+            
+            for (long long value=From; (Step > 0) and (value <= To); value+=Step)
+            {
+                values.push_back(value);
+            }
+            
+            return values;
+        }
+        
+        /** Returns From, From * Base, From * Base * Base and so on, up to and including To.
+            With the default Base of 2, e.g. powers(1024, 1 << 30) sweeps working sets from 1 KB to 1 GB. */
+        static const std::vector<long long> powers (const long long& From, const long long& To, const long long& Base=2)
+        {
+            std::vector<long long> values;
+            
+            for (long long value=From; (From > 0) and (Base > 1) and (value <= To); value*=Base)
+            {
+                values.push_back(value);
+                
+                // Stop before the next step would overflow
+                if (value > To / Base)
+                {
+                    break;
+                }
+            }
+            
+            return values;
+        }
+        
+    }; // end struct RCH::NanoRange
+    
+// ------------------------------------------------------------------------------------------
+// OUTPUT UNITS
+// Describes how a timer's DATATYPE is made from nanoseconds. Plain number types are divided by the
+// timebase factor at runtime. std::chrono::duration types have their unit fixed at compile time,
+// so the conversion is a constant the compiler folds, and the runtime timebase doesn't apply.
+    
+    /** Output unit handling for plain number types, scaled by the runtime timebase. */
+    template <typename VALUE>
+    struct NanoUnit
+    {
+        // The type of the runtime timebase factor
+        typedef VALUE Factor;
+        
+        // Is the unit fixed at compile time
+        static const bool fixed = false;
+        
+        // The timebase unit index of a fixed unit
+        static const unsigned int unit = RCH_NANOTIMER_UNIT_AUTOMATIC;
+        
+        /** Scales integer nanoseconds into the timebase. */
+        static const VALUE scale (const RCH_NANOTIMER_TICKS& Nanoseconds, const Factor& TimeFactor)
+        {
+            return static_cast<VALUE>(static_cast<VALUE>(Nanoseconds) / TimeFactor);
+        }
+        
+        /** Scales fractional nanoseconds into the timebase. */
+        static const VALUE scale (const double& Nanoseconds, const Factor& TimeFactor)
+        {
+            return static_cast<VALUE>(Nanoseconds / TimeFactor);
+        }
+        
+        /** Returns a value as a plain number in its unit. */
+        static const double count (const VALUE& Value)
+        {
+            return static_cast<double>(Value);
+        }
+        
+        /** Turns a scaled value back into fractional nanoseconds. */
+        static const double unscale (const VALUE& Value, const Factor& TimeFactor)
+        {
+            return static_cast<double>(Value) * static_cast<double>(TimeFactor);
+        }
+        
+    }; // end struct RCH::NanoUnit
+    
+    /** Output unit handling for std::chrono::duration types, converted at compile time. */
+    template <class REP, class PERIOD>
+    struct NanoUnit<std::chrono::duration<REP,PERIOD> >
+    {
+        typedef std::chrono::duration<REP,PERIOD> Value;
+        
+        // The runtime timebase still exists, but is ignored
+        typedef double Factor;
+        
+        static const bool fixed = true;
+        
+        // Units without a text label of their own are formatted in automatic mode
+        static const unsigned int unit = std::ratio_equal<PERIOD,std::nano>::value ? RCH_NANOTIMER_UNIT_NANOSECONDS :
+                                         std::ratio_equal<PERIOD,std::micro>::value ? RCH_NANOTIMER_UNIT_MICROSECONDS :
+                                         std::ratio_equal<PERIOD,std::milli>::value ? RCH_NANOTIMER_UNIT_MILLISECONDS :
+                                         std::ratio_equal<PERIOD,std::ratio<1> >::value ? RCH_NANOTIMER_UNIT_SECONDS :
+                                         std::ratio_equal<PERIOD,std::ratio<60> >::value ? RCH_NANOTIMER_UNIT_MINUTES :
+                                         std::ratio_equal<PERIOD,std::ratio<3600> >::value ? RCH_NANOTIMER_UNIT_HOURS :
+                                         RCH_NANOTIMER_UNIT_AUTOMATIC;
+        
+        static const Value scale (const RCH_NANOTIMER_TICKS& Nanoseconds, const Factor&)
+        {
+            return std::chrono::duration_cast<Value>(std::chrono::duration<RCH_NANOTIMER_TICKS,std::nano>(Nanoseconds));
+        }
+        
+        static const Value scale (const double& Nanoseconds, const Factor&)
+        {
+            return std::chrono::duration_cast<Value>(std::chrono::duration<double,std::nano>(Nanoseconds));
+        }
+        
+        /** Returns a value as a plain number in its unit, or in nanoseconds if the unit has no text label. */
+        static const double count (const Value& Duration)
+        {
+            if (unit == RCH_NANOTIMER_UNIT_AUTOMATIC)
+            {
+                return std::chrono::duration_cast<std::chrono::duration<double,std::nano> >(Duration).count();
+            }
+            
+            return static_cast<double>(Duration.count());
+        }
+        
+        /** Turns a duration back into fractional nanoseconds. */
+        static const double unscale (const Value& Duration, const Factor&)
+        {
+            return std::chrono::duration_cast<std::chrono::duration<double,std::nano> >(Duration).count();
+        }
+        
+    }; // end struct RCH::NanoUnit
+    
+    /** Creates a high precision timer.
+        DATATYPE is the number format of returned (scaled, not formatted) timestamps and intervals.
+        It can also be a std::chrono::duration, which fixes the unit at compile time, see NanoUnitTimer.
+        CLOCK is the clock backend that split time events are read from, see NanoSystemClock.
+        Use the RCH::NanoTimer shorthand for a timer with the default number format and clock. */
+    template <typename DATATYPE=RCH_NANOTIMER_DATATYPE, class CLOCK=NanoSystemClock>
+    class BasicNanoTimer
+    {
+    public:
+        
+        /** What benchmark() returns for a function: its result, or the timed interval if it returns nothing. */
+        template <class FUNCTION, class... ARGUMENTS>
+        using NanoBenchmarkResult = typename std::conditional<std::is_void<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >::value, DATATYPE, NanoInvoke::Result<FUNCTION,ARGUMENTS...> >::type;
+        
+        BasicNanoTimer ()
+        {
+            initialize();
+        }
+        
+        /** Constructor that overrides decimal precision and label display formatting */
+        BasicNanoTimer (const unsigned int& Precision, const bool& DisplayLabel)
+        {
+            formatting.precision = Precision;
+            formatting.label = DisplayLabel;
+            
+            initialize();
+        }
+        
+        /** Constructor that sets up a fixed capacity split arena right away, see arena(). */
+        explicit BasicNanoTimer (const unsigned int& Capacity)
+        {
+            initialize();
+            
+            arena(Capacity);
+        }
+        
+        ~BasicNanoTimer () {}
+        
+// ------------------------------------------------------------------------------------------
+// TIMEBASE FACTOR
+        
+        /** Contains methods to switch the timer's time base for retrieved values.
+            The timer will always store full precision integer clock ticks,
+            but the timebase can be used to scale output values to other timebases
+            like milliseconds or full seconds. Timers that return std::chrono durations
+            have their unit fixed at compile time, and are not affected by this. */
+        struct Timebase
+        {
+        private:
+            
+            // The factor type, the timer's number format, or double for std::chrono durations
+            typedef typename NanoUnit<DATATYPE>::Factor Factor;
+            
+            // The currently set time base, nanoseconds by default
+            Factor timefactor = RCH_NANOTIMER_NANOSECONDS;
+            
+            // Index of the currently set time base, see unit()
+            unsigned int timeunit = RCH_NANOTIMER_UNIT_NANOSECONDS;
+            
+        public:
+            
+            /** Returns the currently set timebase factor by which the original
+                full precision timestamps are divided when output. */
+            const Factor& factor () const
+            {
+                return timefactor;
+            }
+            
+            /** Returns the currently set timebase as an index, from 0 for nanoseconds up to 5 for hours,
+                or 6 in automatic mode. */
+            const unsigned int& unit () const
+            {
+                return timeunit;
+            }
+            
+            /** Switches the timebase to nanoseconds. */
+            void nanoseconds ()
+            {
+                timefactor = RCH_NANOTIMER_NANOSECONDS;
+                timeunit = RCH_NANOTIMER_UNIT_NANOSECONDS;
+            }
+            
+            /** Switches the timebase to microseconds. */
+            void microseconds ()
+            {
+                timefactor = RCH_NANOTIMER_MICROSECONDS;
+                timeunit = RCH_NANOTIMER_UNIT_MICROSECONDS;
+            }
+            
+            /** Switches the timebase to milliseconds. */
+            void milliseconds ()
+            {
+                timefactor = RCH_NANOTIMER_MILLISECONDS;
+                timeunit = RCH_NANOTIMER_UNIT_MILLISECONDS;
+            }
+            
+            /** Switches the timebase to seconds. */
+            void seconds ()
+            {
+                timefactor = RCH_NANOTIMER_SECONDS;
+                timeunit = RCH_NANOTIMER_UNIT_SECONDS;
+            }
+            
+            /** Switches the timebase to minutes. */
+            void minutes ()
+            {
+                timefactor = RCH_NANOTIMER_MINUTES;
+                timeunit = RCH_NANOTIMER_UNIT_MINUTES;
+            }
+            
+            /** Switches the timebase to hours. */
+            void hours ()
+            {
+                timefactor = RCH_NANOTIMER_HOURS;
+                timeunit = RCH_NANOTIMER_UNIT_HOURS;
+            }
+            
+            /** Switches the timebase to automatic mode. Values are returned in nanoseconds,
+                and format() picks ns, µs, ms or s for every single value, whichever fits best. */
+            void automatic ()
+            {
+                timefactor = RCH_NANOTIMER_NANOSECONDS;
+                timeunit = RCH_NANOTIMER_UNIT_AUTOMATIC;
+            }
+            
+        } timebase;
+        
+// ------------------------------------------------------------------------------------------
+// FORMAT / BEAUTIFY OUTPUT
+        
+        /** Sets up the timer's formatting precision in post-comma floating point steps, and
+            whether or not to display a text label at the end of formatted value strings. */
+        void format (const unsigned int& Precision, const bool& DisplayLabel)
+        {
+            formatting.precision = Precision;
+            formatting.label = DisplayLabel;
+        }
+        
+        /** Takes a timer value and returns it formatted according to current formatting options. */
+        const std::string format (const DATATYPE& Time) const
+        {
+            char text[RCH_NANOTIMER_FORMAT_LENGTH];
+            
+            return std::string(text, format(Time, text, RCH_NANOTIMER_FORMAT_LENGTH));
+        }
+        
+        /** Writes a timer value into a caller supplied char buffer, formatted according to current formatting
+            options, and returns the number of characters written (not counting the terminating zero).
+            This does no heap allocation and works with integer digits, so it's fast enough to format large
+            tables of values. In automatic timebase mode, it picks ns, µs, ms or s for every value.
+            Precision is limited to 18 post-comma digits. NaN and infinite values are written as "nan", "inf"
+            or "-inf". If the text doesn't fit into Size characters (including the terminating zero), or the
+            whole part of the value doesn't fit into 64 bits, nothing is written and 0 is returned. */
+        const int format (const DATATYPE& Time, char* Buffer, const int& Size) const
+        {
+            double value = NanoUnit<DATATYPE>::count(Time);
+            
+            // These have no digits to split
+            if ((std::isnan(value) == true) or (std::isinf(value) == true))
+            {
+                const char* const word = (std::isnan(value) == true) ? "nan" : (value < 0.0) ? "-inf" : "inf";
+                const int length = static_cast<int>(std::strlen(word));
+                
+                if (length >= Size)
+                {
+                    if (Size > 0)
+                    {
+                        Buffer[0] = 0;
+                    }
+                    
+                    return 0;
+                }
+                
+                std::memcpy(Buffer, word, static_cast<std::size_t>(length + 1));
+                
+                return length;
+            }
+            
+            unsigned int unit = (NanoUnit<DATATYPE>::fixed == true) ? static_cast<unsigned int>(NanoUnit<DATATYPE>::unit) : timebase.unit();
+            const bool automatic = (unit == RCH_NANOTIMER_UNIT_AUTOMATIC);
+            
+            // Pick the largest unit that still leaves a value of at least one
+            if (automatic == true)
+            {
+                const double magnitude = std::fabs(value);
+                
+                unit = (magnitude < 1000.0) ? RCH_NANOTIMER_UNIT_NANOSECONDS : (magnitude < 1000000.0) ? RCH_NANOTIMER_UNIT_MICROSECONDS : (magnitude < 1000000000.0) ? RCH_NANOTIMER_UNIT_MILLISECONDS : RCH_NANOTIMER_UNIT_SECONDS;
+                value /= static_cast<double>(power(3 * unit));
+            }
+            
+            const unsigned int precision = std::min(formatting.precision, 18u);
+            const bool negative = (value < 0.0);
+            
+            value = std::fabs(value);
+            
+            // The whole part has to fit into the integer digits below, 2^64 and up can't be converted
+            if (value >= 18446744073709551616.0)
+            {
+                if (Size > 0)
+                {
+                    Buffer[0] = 0;
+                }
+                
+                return 0;
+            }
+            
+            // Split into whole and fractional part, and round the fraction to the wanted number of digits
+            std::uint64_t integer, fraction;
+            
+            splitDigits(value, precision, integer, fraction);
+            
+            // Rounding may carry the value into the next unit, e.g. 999.999 ns is 1.00 µs at two digits
+            if ((automatic == true) and (integer >= 1000) and (unit < RCH_NANOTIMER_UNIT_SECONDS))
+            {
+                ++unit;
+                
+                splitDigits(value / 1000.0, precision, integer, fraction);
+            }
+            
+            char text[RCH_NANOTIMER_FORMAT_LENGTH];
+            int length = 0;
+            
+            if ((negative == true) and ((integer > 0) or (fraction > 0)))
+            {
+                text[length++] = '-';
+            }
+            
+            // Whole part, digits come out back to front
+            char digits[20];
+            int count = 0;
+            
+            do
+            {
+                digits[count++] = static_cast<char>('0' + integer % 10);
+                integer /= 10;
+            }
+            while (integer > 0);
+            
+            while (count > 0)
+            {
+                text[length++] = digits[--count];
+            }
+            
+            // Fractional part, padded with leading zeros
+            if (precision > 0)
+            {
+                text[length++] = '.';
+                
+                for (unsigned int digit=precision; digit>0; --digit)
+                {
+                    text[length++] = static_cast<char>('0' + (fraction / power(digit - 1)) % 10);
+                }
+            }
+            
+            // If a text label should be added to the end of the string
+            if (formatting.label == true)
+            {
+                for (const char* character=unitLabel(unit); *character!=0; ++character)
+                {
+                    text[length++] = *character;
+                }
+            }
+            
+            if (length >= Size)
+            {
+                if (Size > 0)
+                {
+                    Buffer[0] = 0;
+                }
+                
+                return 0;
+            }
+            
+            std::memcpy(Buffer, text, static_cast<std::size_t>(length));
+            Buffer[length] = 0;
+            
+            return length;
+        }
+        
+        /** Takes a timer value along with formatting arguments and returns it formatted as specified.
+            This will update the timer's formatting options and affect later calls to format(). */
+        const std::string format (const DATATYPE& Time, const int& Precision, const bool& DisplayLabel)
+        {
+            // Update formatting settings first
+            format(Precision,DisplayLabel);
+            
+            // Then return the formatted time value as a string
+            return format(Time);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// LABELS
+        
+        /** Small precomputed handle that identifies a split ID without carrying the string itself.
+            Fetch one through label() before timing starts, then pass it to split(), start() or stop()
+            to record split time events without any string handling or heap allocation. */
+        struct NanoLabel
+        {
+            NanoLabel () {}
+            
+            explicit NanoLabel (const unsigned int& Handle) : handle(Handle) {}
+            
+            // Index into the timer's label table, or unlabelled if no ID is attached
+            unsigned int handle = RCH_NANOTIMER_UNLABELLED;
+            
+        }; // end struct NanoLabel
+        
+        /** Registers a split ID string with this timer and returns its label handle.
+            The ID is interned only once, registering the same ID again (in any letter case)
+            returns the same handle through a hash lookup. Handles stay valid across reset() and start(). */
+        const NanoLabel label (const std::string& ID)
+        {
+            // Empty IDs map to unlabelled splits, which are named by sequential numbers later
+            if (ID.empty())
+            {
+                return NanoLabel();
+            }
+            
+            // In concurrent and tracing mode, several threads may register labels at the same time
+            std::unique_lock<std::mutex> lock;
+            
+            if (labelMutex() != nullptr)
+            {
+                lock = std::unique_lock<std::mutex>(*labelMutex());
+            }
+            
+            // Reuse the handle if this ID was registered before
+            const typename NanoLabelIndex::const_iterator found = labelIndex.find(ID);
+            
+            if (found != labelIndex.end())
+            {
+                return NanoLabel(found->second);
+            }
+            
+            // Otherwise add the ID to the label table
+            return registerLabel(ID);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// SPLIT ARENA
+        
+        /** Switches the timer into fixed capacity recording mode.
+            Storage for Capacity split time events (including start and stop) is allocated once
+            right here, and is kept across reset() and start(). While in this mode, the timer
+            never grows its storage, so split(NanoLabel) does no heap allocation and no string work.
+            Splits that do not fit into the arena anymore are discarded and return zero.
+            Passing a Capacity of 0 switches back to the default, unbounded recording mode. */
+        void arena (const unsigned int& Capacity)
+        {
+            capacity = Capacity;
+            
+            // Allocate all storage up front, so recording never has to
+            splits.reserve(capacity);
+            
+            if (counterGroup.state)
+            {
+                counterSplits.reserve(capacity);
+            }
+        }
+        
+// ------------------------------------------------------------------------------------------
+// CONCURRENT RECORDING
+        
+        /** Switches concurrent recording on or off, it's off by default. Must not be called while running.
+            While on, split() may be called from any number of threads at the same time. Every thread
+            records into its own buffer without taking any locks, and all buffers are merged (ordered
+            by time) when the timer is stopped. Split time events can only be queried after stop().
+            In arena mode, every thread's buffer gets the arena's capacity.
+            Register labels up front through label() to keep string work out of the recording threads. */
+        void concurrent (const bool& Concurrent)
+        {
+            reset();
+            
+            tracer.state.reset();
+            concurrency.state.reset((Concurrent == true) ? new NanoConcurrency() : nullptr);
+        }
+        
+        /** Returns the ID of the thread that recorded a split time event, see NanoThread::id().
+            The index Number can be negative to select an index counting from the back. (-1 for last) */
+        const unsigned int thread (const int& Number) const
+        {
+            const int splitIndex = indexFromPosition(Number);
+            
+            // If no split record was found at the queried index, then return zero as default
+            return (splitIndex > -1) ? splits[splitIndex].thread : 0;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// TRACING
+        
+        /** Switches tracing mode on, or off when passing a Size of 0. It's off by default.
+            Must not be called while other threads are recording.
+            In tracing mode, split() may be called from any number of threads at any time, whether the
+            timer is running or not. Every thread writes into its own fixed size ring buffer of Size events
+            (rounded up to a power of two), overwriting its oldest events once the ring is full. Recording
+            takes no locks and does no allocation after a thread's first event, so memory use and cost per
+            event stay constant no matter how long tracing is left on. Use drain() to read the events. */
+        void trace (const unsigned int& Size)
+        {
+            reset();
+            
+            concurrency.state.reset();
+            tracer.state.reset();
+            
+            if (Size > 0)
+            {
+                // Round up to a power of two, so ring positions wrap with a bit mask
+                unsigned int ringSize = 1;
+                
+                while (ringSize < Size)
+                {
+                    ringSize <<= 1;
+                }
+                
+                tracer.state.reset(new NanoTracer(ringSize));
+            }
+        }
+        
+        /** Snapshots every thread's trace ring into the timer's split time events, without stopping the
+            recording threads. Only events recorded since the last drain() are collected, ordered by time,
+            and they replace whatever split time events the timer held before. Can be called on demand,
+            or periodically from a background thread. Rings of threads that have exited are freed once read.
+            Returns the number of collected events. */
+        const int drain ()
+        {
+            if (!tracer.state)
+            {
+                return 0;
+            }
+            
+            NanoTracer& state = *tracer.state;
+            
+            std::lock_guard<std::mutex> lock (state.mutex);
+            
+            splits.clear();
+            
+            for (typename std::unordered_map<unsigned int,std::shared_ptr<NanoTraceRing> >::iterator item=state.rings.begin(); item!=state.rings.end(); )
+            {
+                NanoTraceRing& ring = *item->second;
+                
+                // Check this before reading the head, so a finished ring's last events are always collected
+                const bool finished = ring.finished.load(std::memory_order_acquire);
+                
+                const std::uint64_t head = ring.head.load(std::memory_order_acquire);
+                
+                // Events older than one full ring have already been overwritten
+                const std::uint64_t first = std::max(ring.drained, (head > state.size) ? head - state.size : 0);
+                
+                state.dropped += first - ring.drained;
+                
+                for (std::uint64_t position=first; position<head; ++position)
+                {
+                    NanoTraceSlot& slot = ring.slots[position & (state.size - 1)];
+                    
+                    const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                    const RCH_NANOTIMER_TICKS ticks = slot.ticks.load(std::memory_order_relaxed);
+                    const unsigned int handle = slot.label.load(std::memory_order_relaxed);
+                    
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    
+                    // Skip the event if its slot was overwritten while being read
+                    if ((sequence == position + 1) and (slot.sequence.load(std::memory_order_relaxed) == sequence))
+                    {
+                        splits.push_back(NanoSplit(NanoLabel(handle), ticks, ring.thread));
+                    }
+                    else
+                    {
+                        ++state.dropped;
+                    }
+                }
+                
+                ring.drained = head;
+                
+                // The owning thread is gone, so the ring won't ever hold new events
+                if (finished == true)
+                {
+                    item = state.rings.erase(item);
+                }
+                else
+                {
+                    ++item;
+                }
+            }
+            
+            std::stable_sort(splits.begin(), splits.end(), earlier);
+            
+            reindex();
+            
+            return numSplits();
+        }
+        
+        /** Returns how many traced events were overwritten before drain() could collect them. */
+        const unsigned long long dropped ()
+        {
+            if (!tracer.state)
+            {
+                return 0;
+            }
+            
+            std::lock_guard<std::mutex> lock (tracer.state->mutex);
+            
+            return tracer.state->dropped;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// SELF-OVERHEAD CALIBRATION
+        
+        /** Scaled (not formatted) statistics about how long the timer takes to record one split time event. */
+        struct NanoOverhead
+        {
+            DATATYPE minimum = DATATYPE(0);
+            DATATYPE median = DATATYPE(0);
+            DATATYPE deviation = DATATYPE(0);
+            
+            // How many splits were measured to get these values, zero if the timer was never calibrated
+            unsigned int samples = 0;
+            
+        }; // end struct NanoOverhead
+        
+        /** Measures the timer's own per-split overhead on this machine and stores it.
+            Records Samples back-to-back splits by label handle into a scratch timer of the same type,
+            the gaps between them are what the timer itself costs: reading the clock plus bookkeeping.
+            Does not touch this timer's splits. Returns the measured overhead, see overhead(). */
+        const NanoOverhead calibrate (const unsigned int& Samples=RCH_NANOTIMER_DEFAULT_CALIBRATION_SAMPLES)
+        {
+            // Use an arena, so the scratch timer records exactly the way a hot path would
+            BasicNanoTimer scratch (Samples + 1);
+            
+            scratch.start();
+            
+            for (unsigned int sample=0; sample<Samples; ++sample)
+            {
+                scratch.split(NanoLabel());
+            }
+            
+            // The gap between each pair of consecutive splits, in nanoseconds
+            std::vector<RCH_NANOTIMER_TICKS> gaps;
+            std::vector<RCH_NANOTIMER_TICKS> gapTicks;
+            
+            for (int item=1; item<scratch.numSplits(); ++item)
+            {
+                const RCH_NANOTIMER_TICKS ticks = scratch.splits[item].ticks - scratch.splits[item - 1].ticks;
+                
+                gapTicks.push_back(ticks);
+                gaps.push_back(toNanoseconds(ticks));
+            }
+            
+            overheadStats = NanoOverheadStats();
+            
+            if (gaps.empty() == false)
+            {
+                // Mean and standard deviation over all gaps
+                double mean = 0.0;
+                
+                for (unsigned int item=0; item<gaps.size(); ++item)
+                {
+                    mean += static_cast<double>(gaps[item]);
+                }
+                
+                mean /= static_cast<double>(gaps.size());
+                
+                double variance = 0.0;
+                
+                for (unsigned int item=0; item<gaps.size(); ++item)
+                {
+                    variance += (static_cast<double>(gaps[item]) - mean) * (static_cast<double>(gaps[item]) - mean);
+                }
+                
+                // Minimum and median need the gaps in order
+                std::sort(gaps.begin(), gaps.end());
+                std::sort(gapTicks.begin(), gapTicks.end());
+                
+                overheadStats.minimum = static_cast<double>(gaps.front());
+                overheadStats.median = static_cast<double>(gaps[gaps.size() / 2]);
+                overheadStats.deviation = std::sqrt(variance / static_cast<double>(gaps.size()));
+                overheadStats.samples = static_cast<unsigned int>(gaps.size());
+                overheadStats.ticks = gapTicks[gapTicks.size() / 2];
+            }
+            
+            return overhead();
+        }
+        
+        /** Returns the scaled (not formatted) overhead statistics stored by the last calibrate() call. */
+        const NanoOverhead overhead () const
+        {
+            NanoOverhead result;
+            
+            result.minimum = scaleNanoseconds(overheadStats.minimum);
+            result.median = scaleNanoseconds(overheadStats.median);
+            result.deviation = scaleNanoseconds(overheadStats.deviation);
+            result.samples = overheadStats.samples;
+            
+            return result;
+        }
+        
+        /** Switches automatic overhead subtraction on or off, it's off by default.
+            While on, every interval() (and so every benchmark() result) has the calibrated median
+            overhead subtracted once for each split time event it spans. Results never go below zero.
+            Has no effect until calibrate() was called. */
+        void compensate (const bool& Compensate)
+        {
+            compensation = Compensate;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// HARDWARE COUNTERS
+        
+        /** Switches hardware counter sampling on or off, it's off by default. Must not be called while running.
+            While on, every split time event also reads the CPU counters of the thread that called this, so
+            counters() can tell the cycles, instructions, cache misses and branch misses of every interval.
+            Reading the counters is a system call, which makes every split a lot more expensive.
+            Concurrent and traced split time events don't read counters.
+            Returns false if perf events aren't supported or permitted, all counts are zero then. */
+        const bool counting (const bool& Counting)
+        {
+            reset();
+            
+            counterGroup.state.reset((Counting == true) ? new NanoCounterGroup() : nullptr);
+            
+            // Arena mode must not allocate while recording
+            if (counterGroup.state)
+            {
+                counterSplits.reserve(capacity);
+            }
+            
+            return (counterGroup.state) and (counterGroup.state->isValid() == true);
+        }
+        
+        /** Returns the hardware counts between the start and stop split time events, see counting().
+            If this is called while the timer is still running, the counts up to now are returned. */
+        const NanoCounters counters () const
+        {
+            if (countedSplits() == 0)
+            {
+                return NanoCounters();
+            }
+            
+            // Read the current counts while running, otherwise use the stop split time event
+            const NanoCounters end = (running == true) ? counterGroup.state->read() : counterSplits.back();
+            
+            return end.since(counterSplits.front());
+        }
+        
+        /** Returns the hardware counts between two split time events.
+            Negative index numbers are possible to count from the back of the split time event storage. */
+        const NanoCounters counters (const int& Split, const int& OtherSplit) const
+        {
+            return counterDifference(indexFromPosition(Split), indexFromPosition(OtherSplit));
+        }
+        
+        /** Returns the hardware counts between the start split and another split time event matching the
+            passed split ID string. If no split has this ID, looks for a "start ID" and "stop ID" stage instead. */
+        const NanoCounters counters (const std::string& SplitID) const
+        {
+            const int index = indexFromSplitID(SplitID);
+            
+            if (index > -1)
+            {
+                return counterDifference(0, index);
+            }
+            
+            const typename NanoStageIndex::const_iterator stage = stages.find(SplitID);
+            
+            if ((stage != stages.end()) and (stage->second.start != RCH_NANOTIMER_UNLABELLED) and (stage->second.stop != RCH_NANOTIMER_UNLABELLED))
+            {
+                return counterDifference(labels[stage->second.start].first, labels[stage->second.stop].first);
+            }
+            
+            return NanoCounters();
+        }
+        
+        /** Returns the hardware counts between two split time events, located by their string IDs/names. */
+        const NanoCounters counters (const std::string& SplitID, const std::string& OtherSplitID) const
+        {
+            return counterDifference(indexFromSplitID(SplitID), indexFromSplitID(OtherSplitID));
+        }
+        
+// ------------------------------------------------------------------------------------------
+// RESET
+        
+        /** Hard reset, stops the timer if currently running and deletes all saved split time events. */
+        void reset ()
+        {
+            // Reset the running flag to "not running" state
+            running = false;
+            
+            // Wait for all recording threads and throw away whatever they buffered
+            if (concurrency.state)
+            {
+                concurrency.state->active = false;
+                
+                collect(false);
+            }
+            
+            // Tracing threads may register labels at any time
+            std::unique_lock<std::mutex> lock;
+            
+            if (tracer.state)
+            {
+                lock = std::unique_lock<std::mutex>(tracer.state->mutex);
+            }
+            
+            // Remove all currently saved split time events
+            splits.clear();
+            counterSplits.clear();
+            
+            // Forget where each label was recorded, but keep the labels themselves
+            reindex();
+        }
+        
+// ------------------------------------------------------------------------------------------
+// OPERATION
+        
+        /** Adds a new split time event to the list without stopping the timer.
+            Accepts a string argument ID to help identify this split time event.
+            If no string is passed, uses sequential numbers as IDs. */
+        const DATATYPE split (std::string ID="")
+        {
+            // Only add splits
+            if (recording() == true)
+            {
+                // Resolve the ID to its label handle, then record the split by handle
+                return split(label(ID));
+            }
+            
+            // Return zero if the timer is currently not running
+            return zero();
+        }
+        
+        /** Adds a new split time event to the list without stopping the timer.
+            Accepts a label handle previously fetched through label(). This does no string
+            work at all, and in arena mode it also does not allocate any memory. */
+        const DATATYPE split (const NanoLabel& Label)
+        {
+            // Traced splits go into the calling thread's own ring
+            if (tracer.state)
+            {
+                return splitTrace(Label);
+            }
+            
+            // Concurrent splits go into the calling thread's own buffer
+            if (concurrency.state)
+            {
+                return splitConcurrent(Label);
+            }
+            
+            // Only add splits while running, and only as long as a fixed size arena has room left
+            if ((running == true) and ((capacity == 0) or (numSplits() < static_cast<int>(capacity))))
+            {
+                // Add a new {label,time} record as the latest split
+                splits.push_back(NanoSplit(Label, nowTicks(), NanoThread::id()));
+                
+                // Counters are read right after the clock, so every interval spans one counter read
+                if (counterGroup.state)
+                {
+                    counterSplits.push_back(counterGroup.state->read());
+                }
+                
+                // Keep the label's position index up to date, so lookups by name never have to search
+                indexLatest(Label);
+                
+                // Return the scaled (not formatted) timestamp of the just added split event time
+                return scale(splits.back().ticks);
+            }
+            
+            // Return zero if the timer is currently not running or the arena is full
+            return zero();
+        }
+        
+        /** Starts a new timer run.
+            Does a full reset beforehand, all previously stored splits will be deleted.
+            Accpets a string argument ID to help identify this timer start event.
+            If no string is passed, uses "start" as the split identifier. */
+        const DATATYPE start (std::string ID="")
+        {
+            // Fall back to "start" if no ID was passed
+            return start((ID == "") ? NanoLabel(RCH_NANOTIMER_LABEL_START) : label(ID));
+        }
+        
+        /** Starts a new timer run, identifying the start event by a label handle fetched through label(). */
+        const DATATYPE start (const NanoLabel& Label)
+        {
+            // Erase the slate
+            reset();
+            
+            // Flag the timer as "running" from now on
+            running = true;
+            
+            if (concurrency.state)
+            {
+                concurrency.state->active = true;
+            }
+            
+            // Create a new split time event using the passed label,
+            // and return the scaled (not formatted) timestamp of the just added start event time
+            return split(Label);
+        }
+        
+        /** Stops the timer completely.
+            It will not be possible to add new splits anymore, except after reset() or new start().
+            Accepts a string argument ID to help identify this timer stop event.
+            If no string is passed, uses "stop" as the split identifier. */
+        const DATATYPE stop (std::string ID="")
+        {
+            // It's only possible to trigger a stop event while the timer is actually running
+            if (running == true)
+            {
+                // Fall back to "stop" if no ID was passed
+                return stop((ID == "") ? NanoLabel(RCH_NANOTIMER_LABEL_STOP) : label(ID));
+            }
+            
+            // Return zero if the timer is currently not running
+            return zero();
+        }
+        
+        /** Stops the timer completely, identifying the stop event by a label handle fetched through label(). */
+        const DATATYPE stop (const NanoLabel& Label)
+        {
+            // It's only possible to trigger a stop event while the timer is actually running
+            if (running == true)
+            {
+                // Recording threads are stopped before the stop time is read, so none of their splits can
+                // come later. A thread that still sees the timer active has read its clock before this fence.
+                if (concurrency.state)
+                {
+                    concurrency.state->active = false;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    
+                    const RCH_NANOTIMER_TICKS ticks = nowTicks();
+                    
+                    running = false;
+                    
+                    // Wait for all recording threads, then merge their buffers into the split time events
+                    collect(true);
+                    
+                    // The stop event is always the latest split, other threads may still register labels
+                    std::lock_guard<std::mutex> lock (concurrency.state->mutex);
+                    
+                    splits.push_back(NanoSplit(Label, ticks, NanoThread::id()));
+                    indexLatest(Label);
+                    
+                    return scale(ticks);
+                }
+                
+                // Create a new split time event using the passed label
+                const DATATYPE stopTime = split(Label);
+                
+                // Flat the timer as "not running" from now on
+                running = false;
+                
+                // Return the scaled (not formatted) timestamp of the just added stop event time
+                return stopTime;
+            }
+            
+            // Return zero if the timer is currently not running
+            return zero();
+        }
+        
+// ------------------------------------------------------------------------------------------
+// SPECIFIC POINTS IN TIME
+        
+        /** Returns the current timestamp of the system clock in full nanosecond precision.
+            Split time events are read from the timer's CLOCK backend instead, which may differ. */
+        const RCH_NANOTIMER_TIMESTAMP now () const
+        {
+            return std::chrono::high_resolution_clock::now();
+        }
+        
+        /** Selects and returns (scaled, not formatted) a specific split time event by its numerical index.
+            The index Number can be negative to select an index counting from the back. (-1 for last) */
+        const DATATYPE time (const int& Number) const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Since the index Number can be negative, figure out an actual positive array index
+            const int splitIndex = indexFromPosition(Number);
+            
+            // If a valid and correctly bounded split index was found
+            if (splitIndex > -1)
+            {
+                // Return the scaled (not formatted) timestamp of the split at the found index
+                return scale(splits[splitIndex].ticks);
+            }
+            
+            // If no split record was found at the queried index, then return zero as default
+            return zero();
+        }
+        
+        /** Looks through all saved split time events and searches for a specific string ID.
+            Returns the split's scaled (not formatted) timestamp value, if found. */
+        const DATATYPE time (const std::string& SplitID) const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Fetch the split index for this split ID
+            const int index = indexFromSplitID(SplitID);
+            
+            // If a valid index for this split ID was found
+            if (index > -1)
+            {
+                return time(index);
+            }
+            
+            // If no split record was found to match the queried ID, then return zero as default
+            return zero();
+        }
+        
+// ------------------------------------------------------------------------------------------
 // TIME INTERVAL - START TO STOP
         
-        /** Returns the scaled (not formatted) time difference between the start and stop
-            split time events. If this is called while the timer is still running, the current
-            timestamp will be used as a substitute for the (missing) stop split timestamp. */
-        const RCH_NANOTIMER_DATATYPE interval () const
+        /** Returns the scaled (not formatted) time difference between the start and stop
+            split time events. If this is called while the timer is still running, the current
+            timestamp will be used as a substitute for the (missing) stop split timestamp. */
+        const DATATYPE interval () const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Use the current time while running, otherwise the stop split time event
+            const RCH_NANOTIMER_TICKS end = (running == true) ? nowTicks() : splits.back().ticks;
+            
+            // Ticks are subtracted as integers first, so only the exact difference gets scaled.
+            // While running, reading the current time also costs about one split's overhead.
+            return scale(compensated(end - splits.front().ticks, numSplits() - (running == false)));
+        }
+        
+// ------------------------------------------------------------------------------------------
+// TIME INTERVAL - START TO SPLIT
+        
+        /** Returns the scaled (not formatted) time difference between the
+            start split time event and a passed split time event index number.
+            Negative numbers are possible to count from the back of the split time event storage. */
+        const DATATYPE interval (const int& EndSplitIndex) const
+        {
+            // If currently no split records, or queried split event is (theoretical) start split event
+            if ((numSplits() == 0) or (EndSplitIndex == 0))
+            {
+                // Return zero as default
+                return zero();
+            }
+            // If the queried split event is the stop split event
+            else if (EndSplitIndex == -1)
+            {
+                // Take the easy way out and return the full start-to-end interval
+                return interval();
+            }
+            
+            // Figure out an actual positive array index for the passed split index
+            const int splitIndex = indexFromPosition(EndSplitIndex);
+            
+            // Only if the passed split index points to a valid split time event
+            if (splitIndex > -1)
+            {
+                // Return the scaled (not formatted) time difference between
+                // the start split and the split at the queried index.
+                return difference(0, splitIndex);
+            }
+            
+            // If no valid time interval could be generated from the queried index, return zero as default
+            return zero();
+        }
+        
+        /** Returns the scaled (not formatted) time difference between the start split
+            and another split time event matching the passed split ID string.
+            If no split has this ID, looks for a "start ID" and "stop ID" stage instead. */
+        const DATATYPE interval (const std::string& SplitID) const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Try to find an index for the passed split ID
+            const int index = indexFromSplitID(SplitID);
+            
+            // If a valid index for the passed split ID was found
+            if (index > -1)
+            {
+                // Return the interval between start and split ID
+                return interval(index);
+            }
+            
+            // Since no split has this ID, look up the "start ID" and "stop ID" labels of a stage with this ID
+            const typename NanoStageIndex::const_iterator stage = stages.find(SplitID);
+            
+            // If both the start and the stop label of this stage were registered
+            if ((stage != stages.end()) and (stage->second.start != RCH_NANOTIMER_UNLABELLED) and (stage->second.stop != RCH_NANOTIMER_UNLABELLED))
+            {
+                // Use the first recorded split for either one of them
+                const int index1 = labels[stage->second.start].first;
+                const int index2 = labels[stage->second.stop].first;
+                
+                // If two valid indices were found
+                if ((index1 > -1) and (index2 > -1))
+                {
+                    // Fetch and return the scaled (not formatted) interval between the two indices
+                    return interval(index1,index2);
+                }
+            }
+            
+            // If no valid time interval could be generated from the queried index, return zero as default
+            return zero();
+        }
+        
+// ------------------------------------------------------------------------------------------
+// TIME INTERVAL - SPLIT TO SPLIT
+        
+        /** Returns the scaled (not formatted) time difference between two split time event records.
+            The split time events are located by numbered index values.
+            Negative numbers are possible to count from the back of the split time event storage. */
+        const DATATYPE interval (const int& Split, const int& OtherSplit) const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Filter out the special case where start and stop/last index are passed
+            // Irrelevant to check if both are different, (0,0) or (-1,-1) are OK to just call interval()
+            if (// If the requested first split time event index points to first or (also past) last index
+                ((Split == 0) or (Split == -1) or (Split >= numSplits()))
+                and// If the requested other split time event index points to first or (also past) last index
+                ((OtherSplit == 0) or (OtherSplit == -1) or (OtherSplit >= numSplits()))
+                )
+            {   // Since one split index is start split and one index is stop split,
+                // take the easy way out and just return the full start-to-stop interval
+                return interval();
+            }
+            
+            // Since the Split and OtherSplit indices can be negative, figure out their true positive indexable values
+            const int split1 = indexFromPosition(Split);
+            const int split2 = indexFromPosition(OtherSplit);
+            
+            // If both Split and OtherSplit indices are within bounds of available split time events
+            if ((split1 > -1) and (split2 > -1))
+            {
+                // Return the scaled (not formatted) time difference between the
+                // larger/later split time event and the smaller/earlier split time event.
+                return difference(split1, split2);
+            }
+            
+            // If no valid time interval could be evaluated from the queried indices, return zero as default
+            return zero();
+        }
+        
+        /** Returns the scaled (not formatted) time difference between two split time event records.
+            The split time events are located by their string IDs/names. */
+        const DATATYPE interval (const std::string& SplitID, const std::string& OtherSplitID) const
+        {
+            // If there are no split time events saved anyway, including start or stop
+            if (numSplits() == 0)
+            {
+                // Exit early
+                return zero();
+            }
+            
+            // Try to get the indices for both passed split IDs
+            int split1 = indexFromSplitID(SplitID);
+            int split2 = indexFromSplitID(OtherSplitID);
+            
+            // If both evaluated split time event indices are within a legitimate range
+            if ((split1 > -1) and (split1 < numSplits()) and (split2 > -1) and (split2 < numSplits()))
+            {
+                // Return the scaled (not formatted) time difference between the
+                // larger/later split time event and the smaller/earlier split time event.
+                return difference(split1, split2);
+            }
+            
+            // If no valid time interval could be evaluated from the queried IDs, return zero as default
+            return zero();
+        }
+        
+        const DATATYPE interval (const std::string& SplitID, const int& OtherSplitIndex) const
+        {
+            // Find the Index for the named split
+            int splitIndex1 = indexFromSplitID(SplitID);
+            
+            // If no valid index for the named split was found
+            if (splitIndex1 == -1)
+            {
+                return zero();
+            }
+            
+            // If a valid index was found
+            return interval(splitIndex1, OtherSplitIndex);
+        }
+        
+        const DATATYPE interval (const int& SplitIndex, const std::string& OtherSplitID) const
+        {
+            // Find the Index for the named split
+            int splitIndex2 = indexFromSplitID(OtherSplitID);
+            
+            // If no valid index for the named split was found
+            if (splitIndex2 == -1)
+            {
+                return zero();
+            }
+            
+            // If a valid index was found
+            return interval(SplitIndex, splitIndex2);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - ANONYMOUS AND DISCRETE
+// Use these methods to do right here, right now testing, start and stop the timer immediately.
+        
+        /** Runs anything callable and measures its execution time: functions, lambdas (also with captures),
+            functors and member functions (pass the object or a pointer to it as first argument).
+            Any further Arguments are forwarded to the call. The call is made directly, so it can be inlined.
+            Stops the timer completely after finishing, does not add intermediate split times.
+            If the timed function returns nothing, the return value of this function will be the timed
+            interval (start to end), i.e. how much time passed between the function's start and its termination.
+            If the timed function returns a value, that value is forwarded as the return value of this
+            function instead, this also works for references and move-only types.
+            After the benchmark function finishes, the timer will have split time entries with the
+            start and stop timestamps.
+            Note that if the first argument is a string that the function can't be called with,
+            it is taken as stage ID of a named benchmark instead. */
+        template <class FUNCTION, class... ARGUMENTS>
+        auto benchmark (FUNCTION&& Function, ARGUMENTS&&... Arguments)
+            -> typename std::enable_if<NanoInvoke::IsCallable<FUNCTION,ARGUMENTS...>::value, NanoBenchmarkResult<FUNCTION,ARGUMENTS...> >::type
+        {
+            if (batching.samples > 0)
+            {
+                return timedBatches(std::is_void<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >(), NanoLabel(RCH_NANOTIMER_LABEL_START), NanoLabel(RCH_NANOTIMER_LABEL_STOP), false, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+            }
+            
+            return timed(std::is_void<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >(), NanoLabel(RCH_NANOTIMER_LABEL_START), NanoLabel(RCH_NANOTIMER_LABEL_STOP), false, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - NAMED AND SEQUENTIAL
+// Use these methods to do progressive, staged measurements, adding to a continuously running timer.
+        
+        /** Runs anything callable and measures its execution time, see the anonymous benchmark() above.
+            Does NOT stop the timer after finishing, only adds splits for its own start/stop times.
+            This method requires an ID string to identify this benchmark stage later on, any further
+            Arguments are forwarded to the call.
+            If the timed function returns nothing, the return value of this function will be the timed
+            interval (start to end) of this stage. If the timed function returns a value, that value is
+            forwarded as the return value of this function instead. Either way, the timer will have
+            split time entries with the start and stop timestamps of this stage.
+            If the function can also be called with the ID string as its first argument, e.g. because it
+            takes a const char*, that call wins and is timed anonymously, see above. */
+        template <class FUNCTION, class ID, class... ARGUMENTS>
+        auto benchmark (FUNCTION&& Function, ID&& SplitStageID, ARGUMENTS&&... Arguments)
+            -> typename std::enable_if<NanoInvoke::IsStageID<FUNCTION,ID,ARGUMENTS...>::value, NanoBenchmarkResult<FUNCTION,ARGUMENTS...> >::type
+        {
+            // Resolve the labels for this stage before anything is timed
+            const NanoStageLabel stageLabel = stage(SplitStageID);
+            
+            if (batching.samples > 0)
+            {
+                return timedBatches(std::is_void<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >(), stageLabel.start, stageLabel.stop, true, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+            }
+            
+            return timed(std::is_void<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >(), stageLabel.start, stageLabel.stop, true, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - BATCHED
+// Use these methods to time operations that only take a few nanoseconds, too short for a clock read around every call.
+        
+        /** Scaled (not formatted) per-call time of the last batched benchmark() call, see batch(). */
+        struct NanoBatch
+        {
+            // Mean time of a single call over all batches
+            DATATYPE time = DATATYPE(0);
+            
+            // Half width of the 95% confidence interval of the mean, the time is known to +/- this much
+            DATATYPE error = DATATYPE(0);
+            
+            // How many calls every batch timed, and how many batches were timed
+            unsigned long long iterations = 0;
+            unsigned int samples = 0;
+            
+        }; // end struct NanoBatch
+        
+        /** Switches batched benchmark() timing on, or off when passing 0 Samples. It's off by default.
+            While on, benchmark() doesn't read the clock around one call, but around batches of many calls,
+            so the clock's own cost and resolution are spread over all of them. It first finds how many calls
+            make a batch last SampleTime (zero picks a duration well above the clock's resolution), which also
+            warms up, then times that many batches. The start and stop split time events span all timed
+            batches. Functions that return nothing make benchmark() return the mean time of a single call,
+            the full result including the error estimate is available through batched().
+            Results of every call pass through an optimizer barrier, and the arguments escape before every
+            call, so the compiler can neither drop the calls nor move the work out of the loop. Functions that
+            return a value are called once more after the timed batches, that call's result is returned. */
+        void batch (const unsigned int& Samples=RCH_NANOTIMER_DEFAULT_BATCH_SAMPLES, const std::chrono::nanoseconds& SampleTime=std::chrono::nanoseconds(0))
+        {
+            batching.samples = Samples;
+            batching.sampleTime = SampleTime;
+        }
+        
+        /** Returns the scaled (not formatted) per-call time of the last batched benchmark() call. */
+        const NanoBatch batched () const
+        {
+            NanoBatch result;
+            
+            result.time = scaleNanoseconds(batchStats.time);
+            result.error = scaleNanoseconds(batchStats.error);
+            result.iterations = batchStats.iterations;
+            result.samples = batchStats.samples;
+            
+            return result;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// SCOPED TIMING
+// Use these to time a block of code from where it's entered to wherever it's left, early returns and exceptions included.
+        
+        /** The pair of label handles for the start and stop splits of a named stage. */
+        struct NanoStageLabel
+        {
+            NanoLabel start;
+            NanoLabel stop;
+            
+        }; // end struct NanoStageLabel
+        
+        /** Registers the "start ID" and "stop ID" split IDs of a named stage and returns their label handles.
+            Fetch these once up front, then pass them to scope() to time a block without any string work. */
+        const NanoStageLabel stage (const std::string& SplitStageID)
+        {
+            NanoStageLabel stageLabel;
+            
+            stageLabel.start = label("start " + SplitStageID);
+            stageLabel.stop = label("stop " + SplitStageID);
+            
+            return stageLabel;
+        }
+        
+        /** Adds a "start ID" split when created and a "stop ID" split when destroyed, however its scope is
+            left. Scopes can be nested, the interval of every stage can be queried by its ID afterwards.
+            In profiling mode, scopes add no splits but are aggregated into the call tree instead, see profile(). */
+        class NanoScope
+        {
+        public:
+            
+            NanoScope (BasicNanoTimer& Timer, const NanoStageLabel& Stage) : timer(&Timer), stop(Stage.stop)
+            {
+                if (timer->profiling == true)
+                {
+                    parent = timer->profileCursor;
+                    node = timer->enterNode(Stage.start);
+                    
+                    // Read the clock last, so finding the call tree node isn't timed
+                    entry = timer->nowTicks();
+                }
+                else
+                {
+                    timer->split(Stage.start);
+                }
+            }
+            
+            // Records the time from creation to destruction into a histogram, without adding any splits
+            NanoScope (BasicNanoTimer& Timer, NanoHistogram& Histogram) : timer(&Timer), histogram(&Histogram)
+            {
+                entry = timer->nowTicks();
+            }
+            
+            // Moving hands the pending stop split over to the new scope object
+            NanoScope (NanoScope&& Other) : timer(Other.timer), stop(Other.stop), histogram(Other.histogram), node(Other.node), parent(Other.parent), entry(Other.entry)
+            {
+                Other.timer = nullptr;
+            }
+            
+            ~NanoScope ()
+            {
+                if (timer == nullptr)
+                {
+                    return;
+                }
+                
+                if (histogram != nullptr)
+                {
+                    histogram->record(static_cast<std::uint64_t>(timer->toNanoseconds(timer->compensated(timer->nowTicks() - entry, 1))));
+                }
+                else if (node > -1)
+                {
+                    timer->exitNode(node, parent, timer->nowTicks() - entry);
+                }
+                else
+                {
+                    timer->split(stop);
+                }
+            }
+            
+        private:
+            
+            NanoScope (const NanoScope&) = delete;
+            NanoScope& operator= (const NanoScope&) = delete;
+            
+            BasicNanoTimer* timer;
+            NanoLabel stop;
+            
+            // Histogram that this scope records into instead, if any
+            NanoHistogram* histogram = nullptr;
+            
+            // Call tree node of this scope and of its enclosing scope, only used in profiling mode
+            int node = -1;
+            int parent = -1;
+            
+            // Raw clock ticks when this scope was entered, only used in profiling mode
+            RCH_NANOTIMER_TICKS entry = 0;
+            
+        }; // end class NanoScope
+        
+        /** Starts timing a named stage until the returned scope object is destroyed, see NanoScope.
+            Takes label handles fetched through stage(), so nothing but the two splits happens here. */
+        NanoScope scope (const NanoStageLabel& Stage)
+        {
+            return NanoScope(*this, Stage);
+        }
+        
+        /** Starts timing a named stage until the returned scope object is destroyed, see NanoScope.
+            Resolves the stage's labels first, use the stage() overload above in hot code. */
+        NanoScope scope (const std::string& SplitStageID)
+        {
+            return NanoScope(*this, stage(SplitStageID));
+        }
+        
+        /** Records the time until the returned scope object is destroyed into a latency histogram, in
+            nanoseconds. Adds no split time events, so it can stay on for any number of calls. */
+        NanoScope scope (NanoHistogram& Histogram)
+        {
+            return NanoScope(*this, Histogram);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// CALL TREE PROFILING
+// Use these to keep scoped timing on for a long time, memory only grows with the number of distinct call paths.
+        
+        /** Scaled (not formatted) totals of one call path in the call tree, see listProfile(). */
+        struct NanoProfileEntry
+        {
+            // The stage ID of the scope
+            std::string id;
+            
+            // Nesting level, 0 for outermost scopes
+            int depth = 0;
+            
+            // Index of the enclosing scope's entry in the same list, -1 for outermost scopes
+            int parent = -1;
+            
+            // How often this call path was completed
+            unsigned long long count = 0;
+            
+            // Total time spent in this call path, with and without the time spent in nested scopes
+            DATATYPE inclusive = DATATYPE(0);
+            DATATYPE exclusive = DATATYPE(0);
+            
+            // Shortest and longest single call, inclusive
+            DATATYPE minimum = DATATYPE(0);
+            DATATYPE maximum = DATATYPE(0);
+            
+        }; // end struct NanoProfileEntry
+        
+        /** Switches profiling mode on or off, it's off by default. Either way, the call tree is cleared.
+            Must not be called while any scope is open.
+            In profiling mode, scopes (see scope()) don't add any split time events, whether the timer is
+            running or not. Instead, every scope is aggregated into a call tree node when it's left. Each
+            distinct path of nested stage IDs gets its own node with call count, inclusive and exclusive
+            time, and the shortest and longest call, so memory stays the same no matter how often scopes
+            are entered. If compensate() is on, every call has the calibrated overhead subtracted.
+            Profiling records into the timer itself, so use one timer per thread. */
+        void profile (const bool& Profile)
+        {
+            profiling = Profile;
+            
+            // Start over with only the root node, which stands for "outside of any scope"
+            profileNodes.clear();
+            profileNodes.push_back(NanoProfileNode(NanoLabel(), -1));
+            
+            profileCursor = 0;
+        }
+        
+        /** Exports the call tree depth first, every scope listed before the scopes nested inside it.
+            Values are scaled into the current timebase. */
+        const std::vector<NanoProfileEntry> listProfile () const
+        {
+            std::vector<NanoProfileEntry> entries;
+            
+            if (profileNodes.empty() == false)
+            {
+                listNodes(profileNodes[0].firstChild, 0, -1, entries);
+            }
+            
+            return entries;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - STATISTICAL
+// Use these methods to get reliable numbers, by running a function many times and summarizing the results.
+        
+        /** Settings that control how measure() samples a function. */
+        struct NanoRunSettings
+        {
+            // How many batches to run before sampling starts, to warm up caches and branch predictors
+            unsigned int warmup = RCH_NANOTIMER_DEFAULT_WARMUP;
+            
+            // Lower and upper limit for how many samples are taken
+            unsigned int minSamples = RCH_NANOTIMER_DEFAULT_MINSAMPLES;
+            unsigned int maxSamples = RCH_NANOTIMER_DEFAULT_MAXSAMPLES;
+            
+            // Sampling stops once this much time was spent on samples (after at least minSamples)
+            std::chrono::nanoseconds budget = std::chrono::nanoseconds(RCH_NANOTIMER_DEFAULT_BUDGET);
+            
+            // Sampling stops early once the 95% confidence interval of the mean is narrower than
+            // this fraction of the mean, e.g. 0.01 for +/- 1%. Zero always uses the full budget.
+            double confidence = RCH_NANOTIMER_DEFAULT_CONFIDENCE;
+            
+            // How long a single sample should at least take. Short functions are run in batches until
+            // a batch takes this long. Zero picks a duration well above the clock's resolution.
+            std::chrono::nanoseconds sampleTime = std::chrono::nanoseconds(0);
+            
+            // Pin the measuring thread to this CPU for the whole run, -1 leaves it to the scheduler
+            int cpu = -1;
+            
+            // Raise the measuring thread's scheduling priority for the whole run, where permitted
+            bool priority = false;
+            
+            // Read hardware counters around every sample, see NanoCounters. Where perf events aren't
+            // permitted, measuring works just the same and the counts stay invalid.
+            bool counters = false;
+            
+        }; // end struct NanoRunSettings
+        
+        /** Scaled (not formatted) summary of all samples taken by measure().
+            All times are per single call of the measured function. */
+        struct NanoStatistics
+        {
+            DATATYPE minimum = DATATYPE(0);
+            DATATYPE maximum = DATATYPE(0);
+            DATATYPE mean = DATATYPE(0);
+            DATATYPE median = DATATYPE(0);
+            DATATYPE p90 = DATATYPE(0);
+            DATATYPE p99 = DATATYPE(0);
+            
+            // Sample standard deviation and median absolute deviation
+            DATATYPE deviation = DATATYPE(0);
+            DATATYPE mad = DATATYPE(0);
+            
+            // Number of samples outside of 1.5 times the interquartile range
+            unsigned int outliers = 0;
+            
+            // Number of samples taken, and how many calls of the function each sample timed
+            unsigned int samples = 0;
+            unsigned long long iterations = 0;
+            
+            // The individual per-call sample times, in the order they were taken
+            std::vector<DATATYPE> values;
+            
+            // The CPU the run started on, -1 if unknown, and whether the thread was moved to another
+            // CPU while sampling. Samples from a migrated run are less trustworthy.
+            int cpu = -1;
+            bool migrated = false;
+            
+            // Whether pinning and raising the priority (see NanoRunSettings) actually worked
+            bool pinned = false;
+            bool prioritized = false;
+            
+            // The frequency scaling governor of the CPU the run started on, empty if unknown.
+            // Anything but "performance" means the clock speed may have changed during the run.
+            std::string governor;
+            
+            // Hardware counts per single call, averaged over all samples, if NanoRunSettings asked for them
+            NanoCounters counters;
+            
+        }; // end struct NanoStatistics
+        
+        /** Runs a function many times and returns statistics about how long a single call takes.
+            First finds a batch size so that one sample takes well above the clock's resolution,
+            then runs warmup batches, then takes samples until the time budget is spent or the
+            confidence target is met. Values returned by the function are passed through
+            NanoBarrier::doNotOptimize(), so the compiler can't optimize the calls away.
+            This does not add any split time events to the timer. */
+        template <class FUNCTION>
+        const NanoStatistics measure (FUNCTION Function, const NanoRunSettings& Settings=NanoRunSettings())
+        {
+            // Pin and prioritize the thread before anything runs, this is undone when leaving
+            const NanoIsolation isolation (Settings.cpu, Settings.priority);
+            
+            const int cpu = NanoCpu::current();
+            bool migrated = false;
+            
+            // Counters of this thread, read around every sample but outside of its timed batch
+            const std::unique_ptr<NanoCounterGroup> counterGroup ((Settings.counters == true) ? new NanoCounterGroup() : nullptr);
+            
+            NanoCounters counted;
+            counted.valid = (counterGroup) and (counterGroup->isValid() == true);
+            
+            // Pick the batch size, this also serves as the first part of warming up
+            const unsigned long long iterations = batchSize(Function, Settings.sampleTime);
+            
+            for (unsigned int batch=0; batch<Settings.warmup; ++batch)
+            {
+                runBatch(Function, iterations);
+            }
+            
+            // Per-call sample times in nanoseconds, plus running mean and variance (Welford)
+            std::vector<double> samples;
+            double mean = 0.0;
+            double squares = 0.0;
+            RCH_NANOTIMER_TICKS spent = 0;
+            
+            while (samples.size() < Settings.maxSamples)
+            {
+                const NanoCounters before = (counterGroup) ? counterGroup->read() : NanoCounters();
+                
+                const RCH_NANOTIMER_TICKS ticks = runBatch(Function, iterations);
+                
+                if (counterGroup)
+                {
+                    counted.add(counterGroup->read().since(before));
+                }
+                
+                // Checked between samples, so it doesn't add to the timed batches
+                migrated = (NanoCpu::current() != cpu) or migrated;
+                
+                spent += ticks;
+                
+                const double value = static_cast<double>(toNanoseconds(compensated(ticks, 1))) / static_cast<double>(iterations);
+                
+                samples.push_back(value);
+                
+                const double delta = value - mean;
+                mean += delta / static_cast<double>(samples.size());
+                squares += delta * (value - mean);
+                
+                // Never stop before the minimum amount of samples
+                if (samples.size() < Settings.minSamples)
+                {
+                    continue;
+                }
+                
+                // Stop when the time budget is used up
+                if (toNanoseconds(spent) >= Settings.budget.count())
+                {
+                    break;
+                }
+                
+                // Stop when the mean is known precisely enough
+                if ((Settings.confidence > 0.0) and (samples.size() > 1) and (mean > 0.0))
+                {
+                    const double standardError = std::sqrt(squares / static_cast<double>(samples.size() - 1) / static_cast<double>(samples.size()));
+                    
+                    if (1.96 * standardError / mean <= Settings.confidence)
+                    {
+                        break;
+                    }
+                }
+            }
+            
+            NanoStatistics result = summarize(samples, iterations);
+            
+            result.cpu = cpu;
+            result.migrated = migrated;
+            result.pinned = isolation.pinned();
+            result.prioritized = isolation.prioritized();
+            result.governor = NanoCpu::governor(cpu);
+            
+            if (counterGroup)
+            {
+                result.counters = counted.perCall(samples.size() * iterations);
+            }
+            
+            return result;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - PARALLEL SCALING
+// Use these methods to find out how well a function scales, by running it on more and more threads at once.
+        
+        /** Settings that control how scaling() runs a function. */
+        struct NanoScalingSettings
+        {
+            // Highest number of threads to run at once, zero uses one thread per hardware thread
+            unsigned int threads = 0;
+            
+            // How long every thread count runs for, from the moment all threads are released
+            std::chrono::nanoseconds budget = std::chrono::nanoseconds(RCH_NANOTIMER_DEFAULT_SCALING_BUDGET);
+            
+            // How many batches every thread runs before it waits for the start
+            unsigned int warmup = RCH_NANOTIMER_DEFAULT_WARMUP;
+            
+            // How long a single sample should at least take, see NanoRunSettings
+            std::chrono::nanoseconds sampleTime = std::chrono::nanoseconds(0);
+            
+            // Pin thread number N (counting from zero) to CPU number N
+            bool pin = false;
+            
+        }; // end struct NanoScalingSettings
+        
+        /** Results of scaling() for one thread count, one row of the scaling table. */
+        struct NanoScalingEntry
+        {
+            // How many threads ran the function at the same time
+            unsigned int threads = 0;
+            
+            // Calls per second of all threads together
+            double throughput = 0.0;
+            
+            // Throughput relative to a single thread, and that divided by the number of threads.
+            // An efficiency of 1 is perfect scaling, lower values show contention.
+            double speedup = 0.0;
+            double efficiency = 0.0;
+            
+            // Per-call times over the samples of all threads, and of every thread on its own
+            NanoStatistics latency;
+            std::vector<NanoStatistics> perThread;
+            
+        }; // end struct NanoScalingEntry
+        
+        /** Runs a function on 1, 2, 3 and so on up to Settings.threads threads at once, and returns how
+            throughput and per-call times change with the number of threads, one entry for each count.
+            All threads of a run warm up first, then wait at a barrier, so they all start together.
+            Every thread takes its own samples with its own clock reads until the time budget is spent.
+            The function is called from all threads at the same time, so it has to be thread safe.
+            This does not add any split time events to the timer. */
+        template <class FUNCTION>
+        const std::vector<NanoScalingEntry> scaling (FUNCTION Function, const NanoScalingSettings& Settings=NanoScalingSettings())
+        {
+            const unsigned int maximum = (Settings.threads > 0) ? Settings.threads : std::max(1U, std::thread::hardware_concurrency());
+            
+            // All threads use the same batch size, so their samples are comparable
+            const unsigned long long iterations = batchSize(Function, Settings.sampleTime);
+            
+            std::vector<NanoScalingEntry> entries;
+            
+            for (unsigned int threads=1; threads<=maximum; ++threads)
+            {
+                // Per-call sample times in nanoseconds, and when each thread started and finished sampling
+                std::vector<std::vector<double> > samples (threads);
+                std::vector<RCH_NANOTIMER_TICKS> begins (threads, 0);
+                std::vector<RCH_NANOTIMER_TICKS> ends (threads, 0);
+                
+                std::atomic<unsigned int> waiting (0);
+                std::atomic<bool> released (false);
+                
+                std::vector<std::thread> workers;
+                
+                for (unsigned int worker=0; worker<threads; ++worker)
+                {
+                    workers.push_back(std::thread([&, worker] ()
+                    {
+                        const NanoIsolation isolation ((Settings.pin == true) ? static_cast<int>(worker) : -1);
+                        
+                        for (unsigned int batch=0; batch<Settings.warmup; ++batch)
+                        {
+                            runBatch(Function, iterations);
+                        }
+                        
+                        // Wait at the barrier until every thread has warmed up
+                        ++waiting;
+                        
+                        while (released.load(std::memory_order_acquire) == false)
+                        {
+                            std::this_thread::yield();
+                        }
+                        
+                        begins[worker] = nowTicks();
+                        
+                        do
+                        {
+                            const RCH_NANOTIMER_TICKS ticks = runBatch(Function, iterations);
+                            
+                            samples[worker].push_back(static_cast<double>(toNanoseconds(compensated(ticks, 1))) / static_cast<double>(iterations));
+                            
+                            ends[worker] = nowTicks();
+                        }
+                        while (toNanoseconds(ends[worker] - begins[worker]) < Settings.budget.count());
+                    }));
+                }
+                
+                while (waiting.load() < threads)
+                {
+                    std::this_thread::yield();
+                }
+                
+                released.store(true, std::memory_order_release);
+                
+                for (unsigned int worker=0; worker<threads; ++worker)
+                {
+                    workers[worker].join();
+                }
+                
+                // Throughput counts all calls over the time from the first thread's start to the last thread's end
+                NanoScalingEntry entry;
+                entry.threads = threads;
+                
+                std::vector<double> all;
+                
+                for (unsigned int worker=0; worker<threads; ++worker)
+                {
+                    all.insert(all.end(), samples[worker].begin(), samples[worker].end());
+                    
+                    entry.perThread.push_back(summarize(samples[worker], iterations));
+                }
+                
+                entry.latency = summarize(all, iterations);
+                
+                const RCH_NANOTIMER_TICKS wall = toNanoseconds(*std::max_element(ends.begin(), ends.end()) - *std::min_element(begins.begin(), begins.end()));
+                
+                if (wall > 0)
+                {
+                    entry.throughput = static_cast<double>(all.size() * iterations) * 1000000000.0 / static_cast<double>(wall);
+                }
+                
+                // Compare against the single thread run
+                const double single = (entries.empty() == true) ? entry.throughput : entries.front().throughput;
+                
+                if (single > 0.0)
+                {
+                    entry.speedup = entry.throughput / single;
+                    entry.efficiency = entry.speedup / static_cast<double>(threads);
+                }
+                
+                entries.push_back(entry);
+            }
+            
+            return entries;
+        }
+        
+        /** Returns the entries of a scaling() run as a text table, one line per thread count, with
+            throughput, speedup, efficiency, the median and 99th percentile per-call times, and the
+            median of the slowest thread. Times are formatted in the timer's current timebase. */
+        const std::string scalingTable (const std::vector<NanoScalingEntry>& Entries) const
+        {
+            std::string table = "Threads   Calls/s          Speedup   Efficiency   Median           p99              Slowest thread\n";
+            table += "--------------------------------------------------------------------------------------------------------\n";
+            
+            for (unsigned int item=0; item<Entries.size(); ++item)
+            {
+                const NanoScalingEntry& entry = Entries[item];
+                
+                // The slowest thread is the one with the highest median per-call time
+                DATATYPE slowest = entry.latency.median;
+                
+                for (unsigned int worker=0; worker<entry.perThread.size(); ++worker)
+                {
+                    slowest = (worker == 0) ? entry.perThread[worker].median : std::max(slowest, entry.perThread[worker].median);
+                }
+                
+                char row [128];
+                
+                std::snprintf(row, sizeof(row), "%-9u %-16.0f %-9.3f %-12.3f ", entry.threads, entry.throughput, entry.speedup, entry.efficiency);
+                
+                table += row;
+                
+                appendColumn(table, format(entry.latency.median), 17);
+                appendColumn(table, format(entry.latency.p99), 17);
+                
+                table += format(slowest) + "\n";
+            }
+            
+            return table;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - COMPARISON
+// Use these methods to tell whether one set of timings is really faster or slower than another, see NanoComparison.
+        
+        /** Returns the scaled (not formatted) duration of every recorded run of a stage, in the order they were
+            recorded. A run goes from a "start ID" split time event to the next "stop ID" split time event of the
+            same thread, the way named benchmark() and scope() calls record them. */
+        const std::vector<DATATYPE> samples (const std::string& StageID) const
+        {
+            std::vector<DATATYPE> durations;
+            
+            const typename NanoStageIndex::const_iterator stage = stages.find(StageID);
+            
+            if ((stage == stages.end()) or (stage->second.start == RCH_NANOTIMER_UNLABELLED) or (stage->second.stop == RCH_NANOTIMER_UNLABELLED))
+            {
+                return durations;
+            }
+            
+            // Index of the latest start split time event of every thread that wasn't stopped yet
+            std::unordered_map<unsigned int,int> started;
+            
+            for (int item=0; item<numSplits(); ++item)
+            {
+                const NanoSplit& split = splits[item];
+                
+                if (split.label.handle == stage->second.start)
+                {
+                    started[split.thread] = item;
+                }
+                else if (split.label.handle == stage->second.stop)
+                {
+                    const typename std::unordered_map<unsigned int,int>::iterator start = started.find(split.thread);
+                    
+                    if (start != started.end())
+                    {
+                        durations.push_back(difference(start->second, item));
+                        
+                        started.erase(start);
+                    }
+                }
+            }
+            
+            return durations;
+        }
+        
+        /** Compares two sets of scaled samples, e.g. from samples() or NanoStatistics::values, see NanoComparison. */
+        const NanoComparison compare (const std::vector<DATATYPE>& Baseline, const std::vector<DATATYPE>& Current, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES) const
+        {
+            std::vector<double> baseline;
+            std::vector<double> current;
+            
+            for (unsigned int item=0; item<Baseline.size(); ++item)
+            {
+                baseline.push_back(NanoUnit<DATATYPE>::count(Baseline[item]));
+            }
+            
+            for (unsigned int item=0; item<Current.size(); ++item)
+            {
+                current.push_back(NanoUnit<DATATYPE>::count(Current[item]));
+            }
+            
+            return NanoComparison(baseline, current, Significance, Threshold, Resamples);
+        }
+        
+        /** Compares the samples of two measure() runs, e.g. of two implementations of the same thing. */
+        const NanoComparison compare (const NanoStatistics& Baseline, const NanoStatistics& Current, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES) const
+        {
+            return compare(Baseline.values, Current.values, Significance, Threshold, Resamples);
+        }
+        
+        /** Adds the samples of a measure() run to a baseline under a Name, along with this timer's clock calibration. */
+        void record (NanoBaseline& Baseline, const std::string& Name, const NanoStatistics& Statistics) const
+        {
+            record(Baseline, Name, Statistics.values);
+        }
+        
+        /** Adds all recorded runs of a stage to a baseline under the stage's ID, see samples(). */
+        void record (NanoBaseline& Baseline, const std::string& StageID) const
+        {
+            record(Baseline, StageID, samples(StageID));
+        }
+        
+        /** Adds scaled (not formatted) samples to a baseline under a Name, along with this timer's clock calibration. */
+        void record (NanoBaseline& Baseline, const std::string& Name, const std::vector<DATATYPE>& Samples) const
+        {
+            std::vector<double> nanoseconds;
+            
+            for (unsigned int item=0; item<Samples.size(); ++item)
+            {
+                nanoseconds.push_back(NanoUnit<DATATYPE>::unscale(Samples[item], timebase.factor()));
+            }
+            
+            Baseline.add(Name, nanoseconds);
+            Baseline.calibration(static_cast<double>(CLOCK::nanoseconds(1000000000)) / 1000000000.0);
+        }
+        
+        /** Compares all recorded runs of two stages, see samples(). */
+        const NanoComparison compare (const std::string& BaselineStageID, const std::string& CurrentStageID, const double& Significance=RCH_NANOTIMER_DEFAULT_SIGNIFICANCE, const double& Threshold=RCH_NANOTIMER_DEFAULT_THRESHOLD, const unsigned int& Resamples=RCH_NANOTIMER_DEFAULT_RESAMPLES) const
+        {
+            return compare(samples(BaselineStageID), samples(CurrentStageID), Significance, Threshold, Resamples);
+        }
+        
+// ------------------------------------------------------------------------------------------
+// BENCHMARKING - SUITES
+// Use these methods to run benchmarks over ranges of parameters, e.g. working set sizes, and see where their throughput changes.
+        
+        /** Parameter values of one case of a suite benchmark, one value from each range, in the order the ranges were given. */
+        typedef std::vector<long long> NanoParameters;
+        
+        /** Results of one case of a suite benchmark, one row of the suite table. */
+        struct NanoCase
+        {
+            // Name of the benchmark, and the parameter values of this case
+            std::string name;
+            NanoParameters parameters;
+            
+            // Statistics about a single call, see measure()
+            NanoStatistics statistics;
+            
+            // Bytes or items one call processes, what they are ("B" or "items"), and how many per second,
+            // based on the median call time. Zero, and an empty unit, if the benchmark has no work set.
+            double work = 0.0;
+            std::string unit;
+            double throughput = 0.0;
+            
+        }; // end struct NanoCase
+        
+        /** A set of named benchmarks, each one run for every combination of values of its parameter ranges,
+            see run(). Every case calls the benchmark's setup with its parameters first, which returns the
+            state to run on, e.g. a buffer of the requested size. Only calls of the function on that state
+            are timed, the state is torn down after timing, and setup and teardown are never timed. */
+        class NanoSuite
+        {
+        public:
+            
+            /** What a benchmark processes per call, depending on its parameters. See add(). */
+            class NanoBenchmark
+            {
+            public:
+                
+                /** Sets how many bytes one call processes, so throughput is reported in bytes per second. */
+                template <class WORK>
+                NanoBenchmark& bytes (WORK Work)
+                {
+                    unit = "B";
+                    work = Work;
+                    
+                    return *this;
+                }
+                
+                /** Sets how many items one call processes, so throughput is reported in items per second. */
+                template <class WORK>
+                NanoBenchmark& items (WORK Work)
+                {
+                    unit = "items";
+                    work = Work;
+                    
+                    return *this;
+                }
+                
+            private:
+                
+                friend class BasicNanoTimer;
+                
+                std::string name;
+                std::vector<std::vector<long long> > ranges;
+                
+                // Sets up, measures and tears down one case. The timed function is called through a concrete
+                // type inside of measure(), only this outer, untimed call goes through std::function.
+                std::function<NanoStatistics (BasicNanoTimer&, const NanoParameters&, const NanoRunSettings&)> runner;
+                
+                // Bytes or items processed per call for given parameters, and what they are
+                std::function<double (const NanoParameters&)> work;
+                std::string unit;
+                
+            }; // end class NanoBenchmark
+            
+            /** Adds a benchmark that's run for every combination of values of its Ranges (e.g. from NanoRange).
+                Setup is called with a case's parameters and returns the state to run on, the timed Function is
+                called with a reference to that state, and Teardown is called with it after timing. The state is
+                destroyed after Teardown, so an object that cleans up after itself doesn't need a Teardown at all.
+                Returns the benchmark, to set the work it does per call through bytes() or items().
+                The reference stays valid when more benchmarks are added. */
+            template <class SETUP, class FUNCTION, class TEARDOWN>
+            NanoBenchmark& add (const std::string& Name, const std::vector<std::vector<long long> >& Ranges, SETUP Setup, FUNCTION Function, TEARDOWN Teardown)
+            {
+                NanoBenchmark benchmark;
+                benchmark.name = Name;
+                benchmark.ranges = Ranges;
+                
+                benchmark.runner = [Setup, Function, Teardown] (BasicNanoTimer& Timer, const NanoParameters& Parameters, const NanoRunSettings& Settings) mutable -> NanoStatistics
+                {
+                    auto state = Setup(Parameters);
+                    
+                    const NanoStatistics statistics = Timer.measure([&state, &Function] () { return Function(state); }, Settings);
+                    
+                    Teardown(state);
+                    
+                    return statistics;
+                };
+                
+                benchmarks.push_back(benchmark);
+                
+                return benchmarks.back();
+            }
+            
+            /** Same as above, for states that need no teardown besides being destroyed. */
+            template <class SETUP, class FUNCTION>
+            NanoBenchmark& add (const std::string& Name, const std::vector<std::vector<long long> >& Ranges, SETUP Setup, FUNCTION Function)
+            {
+                return add(Name, Ranges, Setup, Function, NanoNoTeardown());
+            }
+            
+        private:
+            
+            friend class BasicNanoTimer;
+            
+            // Teardown that leaves cleaning up to the state's destructor
+            struct NanoNoTeardown
+            {
+                template <class STATE>
+                void operator() (STATE&) const {}
+            };
+            
+            // A deque, so references returned by add() survive adding more benchmarks
+            std::deque<NanoBenchmark> benchmarks;
+            
+        }; // end class NanoSuite
+        
+        /** Runs every benchmark of a suite for every combination of its parameter values, through measure().
+            The first range changes slowest and the last range fastest. Returns one entry per case, in order. */
+        const std::vector<NanoCase> run (const NanoSuite& Suite, const NanoRunSettings& Settings=NanoRunSettings())
+        {
+            std::vector<NanoCase> cases;
+            
+            for (unsigned int item=0; item<Suite.benchmarks.size(); ++item)
+            {
+                const typename NanoSuite::NanoBenchmark& benchmark = Suite.benchmarks[item];
+                
+                bool empty = false;
+                
+                for (unsigned int range=0; range<benchmark.ranges.size(); ++range)
+                {
+                    empty = benchmark.ranges[range].empty() or empty;
+                }
+                
+                if (empty == true)
+                {
+                    continue;
+                }
+                
+                // Counts through all combinations like an odometer, the last range turning fastest
+                std::vector<size_t> position (benchmark.ranges.size(), 0);
+                
+                while (true)
+                {
+                    NanoCase result;
+                    result.name = benchmark.name;
+                    
+                    for (unsigned int range=0; range<benchmark.ranges.size(); ++range)
+                    {
+                        result.parameters.push_back(benchmark.ranges[range][position[range]]);
+                    }
+                    
+                    result.statistics = benchmark.runner(*this, result.parameters, Settings);
+                    
+                    if (benchmark.work)
+                    {
+                        const double median = NanoUnit<DATATYPE>::unscale(result.statistics.median, timebase.factor());
+                        
+                        result.work = benchmark.work(result.parameters);
+                        result.unit = benchmark.unit;
+                        result.throughput = (median > 0.0) ? result.work * 1000000000.0 / median : 0.0;
+                    }
+                    
+                    cases.push_back(result);
+                    
+                    // Advance to the next combination, or finish once every range wrapped around
+                    int range = static_cast<int>(position.size()) - 1;
+                    
+                    while ((range > -1) and (++position[range] == benchmark.ranges[range].size()))
+                    {
+                        position[range] = 0;
+                        --range;
+                    }
+                    
+                    if (range < 0)
+                    {
+                        break;
+                    }
+                }
+            }
+            
+            return cases;
+        }
+        
+        /** Returns the cases of a suite run as a text table, one line per case, with the parameters, the
+            median and 99th percentile call times, the throughput, and a bar that shows the throughput
+            relative to the benchmark's fastest case. Sudden drops between neighbouring cases, e.g. where a
+            growing working set stops fitting into a cache level, stand out as steps in the bars. */
+        const std::string suiteTable (const std::vector<NanoCase>& Cases) const
+        {
+            std::string table = "Benchmark            Parameters           Median             p99                Throughput\n";
+            table += "------------------------------------------------------------------------------------------------------------------------\n";
+            
+            for (unsigned int item=0; item<Cases.size(); ++item)
+            {
+                const NanoCase& entry = Cases[item];
+                
+                // The bars of every benchmark are relative to its own fastest case
+                double fastest = 0.0;
+                
+                for (unsigned int other=0; other<Cases.size(); ++other)
+                {
+                    fastest = (Cases[other].name == entry.name) ? std::max(fastest, Cases[other].throughput) : fastest;
+                }
+                
+                std::string parameters;
+                
+                for (unsigned int parameter=0; parameter<entry.parameters.size(); ++parameter)
+                {
+                    parameters += ((parameter > 0) ? "/" : "") + std::to_string(entry.parameters[parameter]);
+                }
+                
+                appendColumn(table, entry.name, 21);
+                appendColumn(table, parameters, 21);
+                appendColumn(table, format(entry.statistics.median), 19);
+                appendColumn(table, format(entry.statistics.p99), 19);
+                
+                if (entry.unit.empty() == false)
+                {
+                    appendColumn(table, rate(entry.throughput, entry.unit), 17);
+                    
+                    table.append((fastest > 0.0) ? static_cast<size_t>(entry.throughput / fastest * RCH_NANOTIMER_SUITE_BAR_LENGTH + 0.5) : 0, '#');
+                }
+                
+                table += "\n";
+            }
+            
+            return table;
+        }
+        
+// ------------------------------------------------------------------------------------------
+// EXPORT THE CURRENTLY STORED SPLIT TIMELINE
+        
+        /** Read-only reference to one stored split time event, see view().
+            Nothing is copied or scaled until one of its values is asked for. */
+        class NanoSplitEntry
+        {
+        public:
+            
+            NanoSplitEntry (const BasicNanoTimer& Timer, const int& Index) : timer(&Timer), index(Index) {}
+            
+            /** Returns the full precision timestamp in raw clock ticks. */
+            const std::int64_t ticks () const
+            {
+                return timer->splits[index].ticks;
+            }
+            
+            /** Returns the scaled (not formatted) timestamp in the timer's current timebase. */
+            const DATATYPE time () const
+            {
+                return timer->scale(timer->splits[index].ticks);
+            }
+            
+            /** Returns the label handle, compare it against handles fetched through label() to filter without string work. */
+            const NanoLabel label () const
+            {
+                return timer->splits[index].label;
+            }
+            
+            /** Returns the ID/name, this copies the name into a new string. */
+            const std::string id () const
+            {
+                return timer->name(index);
+            }
+            
+            /** Returns the ID of the thread that recorded the split time event. */
+            const unsigned int thread () const
+            {
+                return timer->splits[index].thread;
+            }
+            
+        private:
+            
+            const BasicNanoTimer* timer;
+            int index;
+            
+        }; // end class NanoSplitEntry
+        
+        /** Random access iterator over stored split time events, yields NanoSplitEntry references by value. */
+        class NanoSplitIterator
+        {
+        public:
+            
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef NanoSplitEntry value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef void pointer;
+            typedef NanoSplitEntry reference;
+            
+            NanoSplitIterator (const BasicNanoTimer& Timer, const int& Index) : timer(&Timer), index(Index) {}
+            
+            NanoSplitEntry operator* () const { return NanoSplitEntry(*timer, index); }
+            NanoSplitEntry operator[] (const difference_type& Offset) const { return NanoSplitEntry(*timer, index + static_cast<int>(Offset)); }
+            
+            NanoSplitIterator& operator++ () { ++index; return *this; }
+            NanoSplitIterator& operator-- () { --index; return *this; }
+            NanoSplitIterator operator++ (int) { NanoSplitIterator previous (*this); ++index; return previous; }
+            NanoSplitIterator operator-- (int) { NanoSplitIterator previous (*this); --index; return previous; }
+            
+            NanoSplitIterator& operator+= (const difference_type& Offset) { index += static_cast<int>(Offset); return *this; }
+            NanoSplitIterator& operator-= (const difference_type& Offset) { index -= static_cast<int>(Offset); return *this; }
+            NanoSplitIterator operator+ (const difference_type& Offset) const { return NanoSplitIterator(*timer, index + static_cast<int>(Offset)); }
+            NanoSplitIterator operator- (const difference_type& Offset) const { return NanoSplitIterator(*timer, index - static_cast<int>(Offset)); }
+            difference_type operator- (const NanoSplitIterator& Other) const { return index - Other.index; }
+            
+            bool operator== (const NanoSplitIterator& Other) const { return index == Other.index; }
+            bool operator!= (const NanoSplitIterator& Other) const { return index != Other.index; }
+            bool operator< (const NanoSplitIterator& Other) const { return index < Other.index; }
+            bool operator> (const NanoSplitIterator& Other) const { return index > Other.index; }
+            bool operator<= (const NanoSplitIterator& Other) const { return index <= Other.index; }
+            bool operator>= (const NanoSplitIterator& Other) const { return index >= Other.index; }
+            
+        private:
+            
+            const BasicNanoTimer* timer;
+            int index;
+            
+        }; // end class NanoSplitIterator
+        
+        /** Non-owning, read-only range over all stored split time events, see view(). */
+        class NanoSplitView
+        {
+        public:
+            
+            explicit NanoSplitView (const BasicNanoTimer& Timer) : timer(&Timer) {}
+            
+            NanoSplitIterator begin () const { return NanoSplitIterator(*timer, 0); }
+            NanoSplitIterator end () const { return NanoSplitIterator(*timer, timer->numSplits()); }
+            
+            const int size () const { return timer->numSplits(); }
+            const bool empty () const { return timer->numSplits() == 0; }
+            
+            NanoSplitEntry operator[] (const int& Index) const { return NanoSplitEntry(*timer, Index); }
+            
+        private:
+            
+            const BasicNanoTimer* timer;
+            
+        }; // end class NanoSplitView
+        
+        /** Returns a view over all split time events currently stored for this timer, without copying
+            anything. Timestamps are only scaled when they're read, in whatever timebase is set by then.
+            The view stays valid as long as the timer exists, but adding or removing splits (or changing
+            the recording mode) while iterating over it invalidates its iterators. */
+        const NanoSplitView view () const
+        {
+            return NanoSplitView(*this);
+        }
+        
+        /** Fills one referenced vector of strings with all IDs/names and fills another vector of numbers
+            with timestamps of all split time events that are currently stored for this timer.
+            The referenced arrays will be resized to fit. If no split time events are currently in
+            storage, then the two referenced vectors will become cleared. */
+        void list (std::vector<std::string>& IDs, std::vector<DATATYPE>& Timestamps) const
+        {
+            IDs.clear();
+            Timestamps.clear();
+            
+            IDs.reserve(numSplits());
+            Timestamps.reserve(numSplits());
+            
+            // Cycle through all currently stored split time events
+            for (int item=0; item<numSplits(); ++item)
+            {
+                // Add the current split time ID/name into the IDs array
+                IDs.push_back(name(item));
+                
+                // Add the current split timestamp into the Timestamps array
+                Timestamps.push_back(scale(splits[item].ticks));
+            }
+        }
+        
+        /** Returns a vector array that contains the timestamps of all split time events
+            currently stored for this timer. If no split time events are in storage, the
+            return value will be an empty vector array. */
+        const std::vector<DATATYPE> listTimes () const
+        {
+            // Initialize the empty vector array that will be returned
+            std::vector<DATATYPE> data;
+            data.reserve(numSplits());
+            
+            // Cycle through all currently stored split time events
+            for (int item=0; item<numSplits(); ++item)
+            {
+                // Add the current split timestamp into the return vector array
+                data.push_back(scale(splits[item].ticks));
+            }
+            
+            // Return the populated vector array
+            // Will be a vector with 0 entries if currently no split time events stored
+            return data;
+        }
+        
+        /** Returns a vector array that contains the IDs/names of all split time events
+            currently stored for this timer. If no split time events are in storage, the
+            return value will be an empty vector array. */
+        const std::vector<std::string> listIds () const
+        {
+            // Initialize the empty vector array that will be returned
+            std::vector<std::string> data;
+            data.reserve(numSplits());
+            
+            // Cycle through all currently stored split time events
+            for (int item=0; item<numSplits(); ++item)
+            {
+                // Add the current split time ID/name into the return vector array
+                data.push_back(name(item));
+            }
+            
+            // Return the populated vector array
+            // Will be a vector with 0 entries if currently no split time events stored
+            return data;
+        }
+        
+        /** Appends all split time events currently stored for this timer to an open binary trace file,
+            and updates the file's label table and clock calibration. To stream a tracing timer into
+            one file, call this after every drain(). Returns false if the writer isn't open. */
+        const bool write (NanoTraceWriter& Writer) const
+        {
+            if (Writer.isOpen() == false)
+            {
+                return false;
+            }
+            
+            Writer.calibration(static_cast<double>(CLOCK::nanoseconds(1000000000)) / 1000000000.0);
+            
+            for (int item=0; item<numSplits(); ++item)
+            {
+                Writer.record(splits[item].ticks, splits[item].label.handle, splits[item].thread);
+            }
+            
+            // Labels only ever get added, so the latest table is valid for all records written so far
+            std::vector<std::string> names;
+            names.reserve(labels.size());
+            
+            for (unsigned int item=0; item<labels.size(); ++item)
+            {
+                names.push_back(labels[item].name);
+            }
+            
+            Writer.labels(names);
+            
+            return true;
+        }
+        
+        /** Saves all split time events currently stored for this timer into a binary trace file,
+            see NanoTraceReader to read it back. Returns false if the file could not be written. */
+        const bool save (const std::string& Path) const
+        {
+            NanoTraceWriter writer;
+            
+            if (writer.open(Path) == false)
+            {
+                return false;
+            }
+            
+            write(writer);
+            
+            return writer.close();
+        }
+        
+        /** Saves all split time events currently stored for this timer as Chrome Trace Event JSON, which
+            chrome://tracing, Perfetto and other local trace viewers can open. Every "start ID" / "stop ID"
+            pair becomes a duration event named ID on the timeline of the thread that recorded it, so nested
+            stages show up nested. All other splits become instant events. Timestamps start at the first split.
+            The JSON is streamed out through a buffer, it's never built up as a whole.
+            Returns false if the file could not be written. */
+        const bool saveChromeTrace (const std::string& Path) const
+        {
+            std::FILE* file = std::fopen(Path.c_str(), "wb");
+            
+            if (file == nullptr)
+            {
+                return false;
+            }
+            
+            bool failed = false;
+            
+            std::string buffer;
+            buffer.reserve(RCH_NANOTIMER_TRACE_BUFFER + 1024);
+            
+            // Work out every label's event type and JSON escaped name once, instead of once per split
+            std::vector<char> phases (labels.size(), 'i');
+            std::vector<std::string> names (labels.size());
+            
+            for (unsigned int item=0; item<labels.size(); ++item)
+            {
+                const std::string& label = labels[item].name;
+                
+                if ((label.compare(0, 6, "start ") == 0) and (label.size() > 6))
+                {
+                    phases[item] = 'B';
+                    appendJson(names[item], label.substr(6));
+                }
+                else if ((label.compare(0, 5, "stop ") == 0) and (label.size() > 5))
+                {
+                    phases[item] = 'E';
+                    appendJson(names[item], label.substr(5));
+                }
+                else
+                {
+                    appendJson(names[item], label);
+                }
+            }
+            
+            buffer += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            
+            const RCH_NANOTIMER_TICKS origin = (numSplits() > 0) ? splits[0].ticks : 0;
+            
+            std::vector<unsigned int> threads;
+            
+            for (int item=0; item<numSplits(); ++item)
+            {
+                const NanoSplit& split = splits[item];
+                const unsigned int handle = split.label.handle;
+                
+                const char phase = (handle != RCH_NANOTIMER_UNLABELLED) ? phases[handle] : 'i';
+                
+                buffer += (item > 0) ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+                
+                if (handle != RCH_NANOTIMER_UNLABELLED)
+                {
+                    buffer += names[handle];
+                }
+                else
+                {
+                    appendJson(buffer, name(item));
+                }
+                
+                buffer += "\",\"ph\":\"";
+                buffer += phase;
+                buffer += (phase == 'i') ? "\",\"s\":\"t\",\"pid\":1,\"tid\":" : "\",\"pid\":1,\"tid\":";
+                appendNumber(buffer, split.thread);
+                
+                // Timestamps are in microseconds, written with all three nanosecond decimals
+                const RCH_NANOTIMER_TICKS nanoseconds = std::max(static_cast<RCH_NANOTIMER_TICKS>(0), toNanoseconds(split.ticks - origin));
+                
+                buffer += ",\"ts\":";
+                appendNumber(buffer, static_cast<std::uint64_t>(nanoseconds / 1000));
+                buffer += '.';
+                buffer += static_cast<char>('0' + (nanoseconds / 100) % 10);
+                buffer += static_cast<char>('0' + (nanoseconds / 10) % 10);
+                buffer += static_cast<char>('0' + nanoseconds % 10);
+                buffer += '}';
+                
+                if (std::find(threads.begin(), threads.end(), split.thread) == threads.end())
+                {
+                    threads.push_back(split.thread);
+                }
+                
+                if (buffer.size() >= RCH_NANOTIMER_TRACE_BUFFER)
+                {
+                    failed = (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) or failed;
+                    buffer.clear();
+                }
+            }
+            
+            // Name every thread's timeline after its thread ID
+            for (unsigned int item=0; item<threads.size(); ++item)
+            {
+                buffer += (numSplits() + item > 0) ? ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" : "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+                appendNumber(buffer, threads[item]);
+                buffer += ",\"args\":{\"name\":\"thread ";
+                appendNumber(buffer, threads[item]);
+                buffer += "\"}}";
+            }
+            
+            buffer += "\n]}\n";
+            
+            failed = (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) or failed;
+            failed = (std::fclose(file) != 0) or failed;
+            
+            return (failed == false);
+        }
+        
+    private:
+        
+// ------------------------------------------------------------------------------------------
+// INTERNAL SECTION - NOT FOR USE OR ACCESS FROM OUTSIDE
+        
+        // Internally used data type for label:time records of captured split time events
+        struct NanoSplit
+        {
+            // Convenience constructor for inline instantiation --> NanoSplit variable (label,123456,1);
+            NanoSplit (const NanoLabel& Label, const RCH_NANOTIMER_TICKS& Ticks, const unsigned int& Thread) : label(Label), ticks(Ticks), thread(Thread) {}
+            
+            // The label handle of the captured split time event, resolved to a name only when queried
+            NanoLabel label;
+            
+            // The full precision timestamp of the captured split time event, in raw integer clock ticks
+            RCH_NANOTIMER_TICKS ticks;
+            
+            // ID of the thread that recorded the split time event, see NanoThread::id()
+            unsigned int thread;
+            
+        }; // end struct NanoSplit
+        
+        // Table that holds value output formatting options
+        struct NanoFormatting
+        {
+            // How many floating point values to keep in format() calls
+            unsigned int precision = RCH_NANOTIMER_DEFAULT_PRECISION;
+            
+            // Should a timebase label be added to the value in format() calls
+            bool label = RCH_NANOTIMER_DEFAULT_DISPLAYLABEL;
+            
+        } formatting;
+        
+        // This is used to keep track if the timer is currently running or stopped.
+        bool running = false;
+        
+        // The "database" that stores all time captured split time events from (and including) start to stop.
+        std::vector<NanoSplit> splits;
+        
+        // Maximum number of split time events in arena mode, zero if storage may grow freely.
+        unsigned int capacity = 0;
+        
+        // Unscaled results of the last calibrate() call, in nanoseconds, plus the median in raw clock ticks.
+        struct NanoOverheadStats
+        {
+            double minimum = 0.0;
+            double median = 0.0;
+            double deviation = 0.0;
+            unsigned int samples = 0;
+            RCH_NANOTIMER_TICKS ticks = 0;
+            
+        } overheadStats;
+        
+        // Should intervals have the calibrated overhead subtracted
+        bool compensation = false;
+        
+        // Batched benchmark() settings, zero samples if off
+        struct NanoBatching
+        {
+            unsigned int samples = 0;
+            std::chrono::nanoseconds sampleTime = std::chrono::nanoseconds(0);
+            
+        } batching;
+        
+        // Unscaled result of the last batched benchmark() call, in nanoseconds per call
+        struct NanoBatchStats
+        {
+            double time = 0.0;
+            double error = 0.0;
+            unsigned long long iterations = 0;
+            unsigned int samples = 0;
+            
+        } batchStats;
+        
+        // One distinct call path in the call tree, accumulated in raw clock ticks
+        struct NanoProfileNode
+        {
+            NanoProfileNode (const NanoLabel& Label, const int& Parent) : label(Label), parent(Parent) {}
+            
+            // The start label of the scope's stage
+            NanoLabel label;
+            
+            // Tree links as node indices, -1 if there is none
+            int parent = -1;
+            int firstChild = -1;
+            int nextSibling = -1;
+            
+            unsigned long long count = 0;
+            RCH_NANOTIMER_TICKS inclusive = 0;
+            RCH_NANOTIMER_TICKS children = 0;
+            RCH_NANOTIMER_TICKS minimum = 0;
+            RCH_NANOTIMER_TICKS maximum = 0;
+            
+        }; // end struct NanoProfileNode
+        
+        // Are scopes aggregated into the call tree instead of adding splits
+        bool profiling = false;
+        
+        // The call tree, node 0 is the root
+        std::vector<NanoProfileNode> profileNodes;
+        
+        // The node of the innermost open scope, 0 if no scope is open
+        int profileCursor = 0;
+        
+        // Moves into the child node of the current node that belongs to a stage, creating it on its first call.
+        const int enterNode (const NanoLabel& Label)
+        {
+            int previous = -1;
+            int child = profileNodes[profileCursor].firstChild;
+            
+            while (child > -1)
+            {
+                if (profileNodes[child].label.handle == Label.handle)
+                {
+                    profileCursor = child;
+                    
+                    return child;
+                }
+                
+                previous = child;
+                child = profileNodes[child].nextSibling;
+            }
+            
+            // First call of this stage from here, append a new node to the current node's children
+            child = static_cast<int>(profileNodes.size());
+            
+            profileNodes.push_back(NanoProfileNode(Label, profileCursor));
+            
+            if (previous > -1)
+            {
+                profileNodes[previous].nextSibling = child;
+            }
+            else
+            {
+                profileNodes[profileCursor].firstChild = child;
+            }
+            
+            profileCursor = child;
+            
+            return child;
+        }
+        
+        // Adds one finished call to a node, and moves back to the node of the enclosing scope.
+        void exitNode (const int& Node, const int& Parent, const RCH_NANOTIMER_TICKS& Ticks)
+        {
+            // The tree was cleared while this scope was open
+            if (Node >= static_cast<int>(profileNodes.size()))
+            {
+                return;
+            }
+            
+            const RCH_NANOTIMER_TICKS elapsed = compensated(Ticks, 1);
+            
+            NanoProfileNode& node = profileNodes[Node];
+            
+            node.minimum = (node.count == 0) ? elapsed : std::min(node.minimum, elapsed);
+            node.maximum = std::max(node.maximum, elapsed);
+            node.inclusive += elapsed;
+            
+            ++node.count;
+            
+            // The enclosing scope needs this to work out its exclusive time
+            profileNodes[Parent].children += elapsed;
+            
+            profileCursor = Parent;
+        }
+        
+        // Appends a node, its siblings after it and all of their children to an exported call tree list.
+        void listNodes (int Node, const int& Depth, const int& Parent, std::vector<NanoProfileEntry>& Entries) const
+        {
+            for (; Node > -1; Node = profileNodes[Node].nextSibling)
+            {
+                const NanoProfileNode& node = profileNodes[Node];
+                
+                NanoProfileEntry entry;
+                
+                // Strip the "start " prefix off the stage's start label
+                entry.id = labels[node.label.handle].name.substr(6);
+                entry.depth = Depth;
+                entry.parent = Parent;
+                entry.count = node.count;
+                entry.inclusive = scale(node.inclusive);
+                entry.exclusive = scale(std::max(static_cast<RCH_NANOTIMER_TICKS>(0), node.inclusive - node.children));
+                entry.minimum = scale(node.minimum);
+                entry.maximum = scale(node.maximum);
+                
+                Entries.push_back(entry);
+                
+                listNodes(node.firstChild, Depth + 1, static_cast<int>(Entries.size()) - 1, Entries);
+            }
+        }
+        
+        // One recording thread's split time events, only ever written by that thread
+        struct NanoThreadBuffer
+        {
+            NanoThreadBuffer () : busy(false) {}
+            
+            // Set while the owning thread is recording, so collect() knows when it's safe to read
+            std::atomic<bool> busy;
+            
+            std::vector<NanoSplit> splits;
+            
+        }; // end struct NanoThreadBuffer
+        
+        // Shared state of concurrent recording mode
+        struct NanoConcurrency
+        {
+            NanoConcurrency () : owner(NanoThread::owner()), active(false) {}
+            
+            // Copies start out empty, they only share the mode
+            NanoConcurrency (const NanoConcurrency&) : NanoConcurrency() {}
+            
+            // Unique number of this state, identifies its buffers in the threads' buffer caches
+            const unsigned long long owner;
+            
+            // The running flag as seen by recording threads
+            std::atomic<bool> active;
+            
+            // Guards the buffer registry and the label table
+            std::mutex mutex;
+            
+            // Every recording thread's buffer, by thread ID
+            std::unordered_map<unsigned int,std::unique_ptr<NanoThreadBuffer> > buffers;
+            
+        }; // end struct NanoConcurrency
+        
+        // One slot of a trace ring. The sequence number is the slot's ring position plus one once the
+        // event is completely written, and zero while it's being overwritten, so readers can tell torn reads.
+        struct NanoTraceSlot
+        {
+            NanoTraceSlot () : sequence(0), ticks(0), label(RCH_NANOTIMER_UNLABELLED) {}
+            
+            std::atomic<std::uint64_t> sequence;
+            std::atomic<RCH_NANOTIMER_TICKS> ticks;
+            std::atomic<unsigned int> label;
+            
+        }; // end struct NanoTraceSlot
+        
+        // One recording thread's trace ring, only ever written by that thread
+        struct NanoTraceRing
+        {
+            explicit NanoTraceRing (const unsigned int& Size) : slots(new NanoTraceSlot[Size]), head(0), drained(0), thread(NanoThread::id()), finished(false) {}
+            
+            std::unique_ptr<NanoTraceSlot[]> slots;
+            
+            // Total number of events ever written into this ring
+            std::atomic<std::uint64_t> head;
+            
+            // Number of events the drainer has already looked at, only touched under the tracer's mutex
+            std::uint64_t drained;
+            
+            // ID of the thread that owns this ring
+            const unsigned int thread;
+            
+            // Set once the owning thread has exited, nothing will be written into this ring anymore
+            std::atomic<bool> finished;
+            
+        }; // end struct NanoTraceRing
+        
+        // Every trace ring a thread registered, marks them finished when the thread exits.
+        // Only holds weak references, so it doesn't keep rings alive that their tracer already freed.
+        struct NanoRingRetirement
+        {
+            ~NanoRingRetirement ()
+            {
+                for (unsigned int item=0; item<rings.size(); ++item)
+                {
+                    const std::shared_ptr<NanoTraceRing> ring = rings[item].lock();
+                    
+                    if (ring)
+                    {
+                        ring->finished.store(true, std::memory_order_release);
+                    }
+                }
+            }
+            
+            // Remembers a newly registered ring, forgetting the ones that were freed in the meantime
+            void add (const std::shared_ptr<NanoTraceRing>& Ring)
+            {
+                rings.erase(std::remove_if(rings.begin(), rings.end(), expired), rings.end());
+                
+                rings.push_back(Ring);
+            }
+            
+            static bool expired (const std::weak_ptr<NanoTraceRing>& Ring)
+            {
+                return Ring.expired();
+            }
+            
+            std::vector<std::weak_ptr<NanoTraceRing> > rings;
+            
+        }; // end struct NanoRingRetirement
+        
+        // Shared state of tracing mode
+        struct NanoTracer
+        {
+            explicit NanoTracer (const unsigned int& Size) : owner(NanoThread::owner()), size(Size), dropped(0) {}
+            
+            // Copies start out empty, they only share the mode and ring size
+            NanoTracer (const NanoTracer& Other) : NanoTracer(Other.size) {}
+            
+            // Unique number of this state, identifies its rings in the threads' buffer caches
+            const unsigned long long owner;
+            
+            // Number of events per ring, always a power of two
+            const unsigned int size;
+            
+            // Guards the ring registry, the drained positions and the label table
+            std::mutex mutex;
+            
+            // Every recording thread's ring, by thread ID. Shared with the recording thread's retirement
+            // list, and freed by drain() once the thread has exited and its ring has been read.
+            std::unordered_map<unsigned int,std::shared_ptr<NanoTraceRing> > rings;
+            
+            // Number of events that were overwritten before they could be drained
+            unsigned long long dropped;
+            
+        }; // end struct NanoTracer
+        
+        // Holds the state of an optional recording mode, if enabled. Copies of a timer get their own, empty state.
+        template <class STATE>
+        struct NanoStateHandle
+        {
+            NanoStateHandle () {}
+            
+            NanoStateHandle (const NanoStateHandle& Other) : state((Other.state) ? new STATE(*Other.state) : nullptr) {}
+            
+            NanoStateHandle& operator= (const NanoStateHandle& Other)
+            {
+                state.reset((Other.state) ? new STATE(*Other.state) : nullptr);
+                
+                return *this;
+            }
+            
+            std::unique_ptr<STATE> state;
+            
+        }; // end struct NanoStateHandle
+        
+        // Concurrent recording state, if enabled
+        NanoStateHandle<NanoConcurrency> concurrency;
+        
+        // Tracing state, if enabled
+        NanoStateHandle<NanoTracer> tracer;
+        
+        // Hardware counters of the thread that switched counting() on, if enabled,
+        // and the counter readings of every split time event recorded since
+        NanoStateHandle<NanoCounterGroup> counterGroup;
+        std::vector<NanoCounters> counterSplits;
+        
+        // The buffers a thread most recently recorded into, one per timer state, so most recorded events
+        // skip the registry lookup even if a thread alternates between several timers.
+        template <class BUFFER>
+        struct NanoBufferCache
+        {
+            struct NanoBufferCacheEntry
+            {
+                unsigned long long owner;
+                BUFFER* buffer;
+                
+            }; // end struct NanoBufferCacheEntry
+            
+            NanoBufferCache () : entries() {}
+            
+            // Returns the cached buffer of the state with the given owner number, or nullptr
+            BUFFER* const find (const unsigned long long& Owner) const
+            {
+                for (unsigned int entry=0; entry<RCH_NANOTIMER_BUFFER_CACHE; ++entry)
+                {
+                    if (entries[entry].owner == Owner)
+                    {
+                        return entries[entry].buffer;
+                    }
+                }
+                
+                return nullptr;
+            }
+            
+            // Remembers a buffer, pushing out the one that was added longest ago if the cache is full
+            void add (const unsigned long long& Owner, BUFFER* const Buffer)
+            {
+                for (unsigned int entry=RCH_NANOTIMER_BUFFER_CACHE-1; entry>0; --entry)
+                {
+                    entries[entry] = entries[entry - 1];
+                }
+                
+                entries[0].owner = Owner;
+                entries[0].buffer = Buffer;
+            }
+            
+            // Owner numbers start at one, so empty entries never match
+            NanoBufferCacheEntry entries[RCH_NANOTIMER_BUFFER_CACHE];
+            
+        }; // end struct NanoBufferCache
+        
+        // True while split time events may be recorded, safe to call from any thread in concurrent mode.
+        // Tracing mode always records.
+        const bool recording () const
         {
-            // Values need to be scaled before summing to avoid floating point precision loss
-            const RCH_NANOTIMER_DATATYPE sNow = scale(now());
-            const RCH_NANOTIMER_DATATYPE sStart = scale(splits.front().time);
-            const RCH_NANOTIMER_DATATYPE sStop = scale(splits.back().time);
+            if (tracer.state)
+            {
+                return true;
+            }
             
-            // Return the calculated interval in scaled (not formatted) form
-            return (running == true) * (sNow - sStart) + (running == false) * (sStop - sStart);
+            return (concurrency.state) ? concurrency.state->active.load() : running;
         }
         
-// ------------------------------------------------------------------------------------------
-// TIME INTERVAL - START TO SPLIT
+        // The mutex that guards the label table, if several threads may use it at the same time.
+        std::mutex* const labelMutex ()
+        {
+            if (tracer.state)
+            {
+                return &tracer.state->mutex;
+            }
+            
+            return (concurrency.state) ? &concurrency.state->mutex : nullptr;
+        }
         
-        /** Returns the scaled (not formatted) time difference between the
-            start split time event and a passed split time event index number.
-            Negative numbers are possible to count from the back of the split time event storage. */
-        const RCH_NANOTIMER_DATATYPE interval (const int& EndSplitIndex) const
+        // Writes a split time event into the calling thread's trace ring, overwriting its oldest event.
+        // This never blocks and never allocates, except on a thread's very first event.
+        const DATATYPE splitTrace (const NanoLabel& Label)
         {
-            // If currently no split records, or queried split event is (theoretical) start split event
-            if ((numSplits() == 0) or (EndSplitIndex == 0))
+            const RCH_NANOTIMER_TICKS ticks = nowTicks();
+            
+            NanoTracer& state = *tracer.state;
+            NanoTraceRing& ring = localRing(state);
+            
+            // Only the owning thread ever moves the head, so it can read it without ordering
+            const std::uint64_t position = ring.head.load(std::memory_order_relaxed);
+            NanoTraceSlot& slot = ring.slots[position & (state.size - 1)];
+            
+            // Invalidate the slot before overwriting it, so a concurrent drain() skips it
+            slot.sequence.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            
+            slot.ticks.store(ticks, std::memory_order_relaxed);
+            slot.label.store(Label.handle, std::memory_order_relaxed);
+            
+            // Publish the event
+            slot.sequence.store(position + 1, std::memory_order_release);
+            ring.head.store(position + 1, std::memory_order_release);
+            
+            return scale(ticks);
+        }
+        
+        // Returns the calling thread's trace ring, registering a new one the first time a thread records.
+        NanoTraceRing& localRing (NanoTracer& State)
+        {
+            static thread_local NanoBufferCache<NanoTraceRing> cache;
+            
+            NanoTraceRing* const cached = cache.find(State.owner);
+            
+            if (cached)
             {
-                // Return zero as default
-                return zero();
+                return *cached;
             }
-            // If the queried split event is the stop split event
-            else if (EndSplitIndex == -1)
+            
+            static thread_local NanoRingRetirement retirement;
+            
+            std::lock_guard<std::mutex> lock (State.mutex);
+            
+            std::shared_ptr<NanoTraceRing>& ring = State.rings[NanoThread::id()];
+            
+            if (!ring)
             {
-                // Take the easy way out and return the full start-to-end interval
-                return interval();
+                ring.reset(new NanoTraceRing(State.size));
+                
+                retirement.add(ring);
             }
             
-            // Fetch the already scaled (not formatted) timestamp value for the passed split index
-            const RCH_NANOTIMER_DATATYPE splitTime = time(EndSplitIndex);
+            cache.add(State.owner, ring.get());
+            
+            return *ring;
+        }
+        
+        // Records a split time event into the calling thread's own buffer, without taking any locks.
+        const DATATYPE splitConcurrent (const NanoLabel& Label)
+        {
+            const RCH_NANOTIMER_TICKS ticks = nowTicks();
+            
+            NanoConcurrency& state = *concurrency.state;
+            NanoThreadBuffer& buffer = localBuffer(state);
             
-            // Only if the time() call found and returned a valid timestamp for the queried split index
-            if (splitTime > 0)
+            bool recorded = false;
+            
+            // Flag the buffer as busy before checking the running state, so collect() either sees
+            // the busy flag and waits, or this thread sees the timer stopped and records nothing.
+            // The fence pairs with the one in collect(), neither side's load may move before its store.
+            buffer.busy.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            
+            if ((state.active == true) and ((capacity == 0) or (buffer.splits.size() < capacity)))
             {
-                // Return the scaled (not formatted) time difference between
-                // the start split and the split at the queried index.
-                return splitTime - scale(splits.front().time);
+                buffer.splits.push_back(NanoSplit(Label, ticks, NanoThread::id()));
+                
+                recorded = true;
             }
             
-            // If no valid time interval could be generated from the queried index, return zero as default
-            return zero();
+            buffer.busy.store(false, std::memory_order_release);
+            
+            return (recorded == true) ? scale(ticks) : zero();
         }
         
-        /** Returns the scaled (not formatted) time difference between the start split
-            and another split time event matching the passed split ID string. */
-        const RCH_NANOTIMER_DATATYPE interval (std::string SplitID) const
+        // Returns the calling thread's buffer, registering a new one the first time a thread records.
+        NanoThreadBuffer& localBuffer (NanoConcurrency& State)
         {
-            // If there are no split time events saved anyway, including start or stop
-            if (numSplits() == 0)
+            static thread_local NanoBufferCache<NanoThreadBuffer> cache;
+            
+            NanoThreadBuffer* const cached = cache.find(State.owner);
+            
+            if (cached)
             {
-                // Exit early
-                return zero();
+                return *cached;
             }
             
-            // Try to find an index for the passed split ID
-            const int index = indexFromSplitID(SplitID);
+            std::lock_guard<std::mutex> lock (State.mutex);
             
-            // If a valid index for the passed split ID was found
-            if (index > -1)
+            std::unique_ptr<NanoThreadBuffer>& buffer = State.buffers[NanoThread::id()];
+            
+            if (!buffer)
             {
-                // Return the interval between start and split ID
-                return interval(index);
+                buffer.reset(new NanoThreadBuffer());
+                buffer->splits.reserve(capacity);
             }
             
-            // Since no valid index was found so far, initialize empty variables for split time event indices
-            int index1 = -1;
-            int index2 = -1;
+            cache.add(State.owner, buffer.get());
+            
+            return *buffer;
+        }
+        
+        // Waits until no thread is recording anymore, then empties all thread buffers.
+        // If Merge is true, their split time events are moved into the timer, ordered by time.
+        void collect (const bool& Merge)
+        {
+            NanoConcurrency& state = *concurrency.state;
+            
+            // The caller just cleared the active flag, this keeps the busy flag loads below from moving
+            // before that store. It pairs with the fence in splitConcurrent().
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            
+            std::lock_guard<std::mutex> lock (state.mutex);
             
-            // If queried ID was not that of start or stop splits, cycle through all splits
-            for (unsigned int item=0; item<numSplits(); ++item)
+            for (typename std::unordered_map<unsigned int,std::unique_ptr<NanoThreadBuffer> >::iterator item=state.buffers.begin(); item!=state.buffers.end(); ++item)
             {
-                // If this split time event's ID matches the start ID for the queried string
-                if (splits[item].name == "start " + SplitID)
+                NanoThreadBuffer& buffer = *item->second;
+                
+                while (buffer.busy.load(std::memory_order_acquire) == true)
+                {
+                    std::this_thread::yield();
+                }
+                
+                if (Merge == true)
                 {
-                    index1 = item;
+                    splits.insert(splits.end(), buffer.splits.begin(), buffer.splits.end());
                 }
-                // If this split time event's ID matches the stop ID for the queried string
-                else if (splits[item].name == "stop " + SplitID)
+                
+                buffer.splits.clear();
+            }
+            
+            if (Merge == true)
+            {
+                std::stable_sort(splits.begin(), splits.end(), earlier);
+                
+                reindex();
+            }
+        }
+        
+        // Orders split time events by time.
+        static bool earlier (const NanoSplit& Split, const NanoSplit& OtherSplit)
+        {
+            return Split.ticks < OtherSplit.ticks;
+        }
+        
+        // Makes the latest stored split the label's latest split, and its first one if it had none yet.
+        void indexLatest (const NanoLabel& Label)
+        {
+            if (Label.handle != RCH_NANOTIMER_UNLABELLED)
+            {
+                NanoLabelRecord& record = labels[Label.handle];
+                
+                record.last = numSplits() - 1;
+                
+                if (record.first == -1)
                 {
-                    index2 = item;
+                    record.first = record.last;
                 }
+            }
+        }
+        
+        // Rebuilds every label's first and latest split index from the stored split time events.
+        void reindex ()
+        {
+            for (unsigned int item=0; item<labels.size(); ++item)
+            {
+                labels[item].first = -1;
+                labels[item].last = -1;
+            }
+            
+            for (unsigned int item=0; item<splits.size(); ++item)
+            {
+                const unsigned int handle = splits[item].label.handle;
                 
-                // If two valid indices were found already
-                if ((index1 > -1) && (index2 > -1))
+                if (handle != RCH_NANOTIMER_UNLABELLED)
                 {
-                    // Fetch and return the scaled (not formatted) interval between the two indices
-                    return interval(index1,index2);
+                    labels[handle].last = static_cast<int>(item);
+                    
+                    if (labels[handle].first == -1)
+                    {
+                        labels[handle].first = static_cast<int>(item);
+                    }
+                }
+            }
+        }
+        
+        // Case insensitive hash for split IDs, so looking up an ID never needs a lowercase copy of it
+        struct NanoLabelHash
+        {
+            size_t operator() (const std::string& ID) const
+            {
+                // FNV-1a over the lowercase characters of the ID
+                size_t hash = 2166136261u;
+                
+                for (unsigned int item=0; item<ID.length(); ++item)
+                {
+                    hash ^= static_cast<size_t>(::tolower(static_cast<unsigned char>(ID[item])));
+                    hash *= 16777619u;
+                }
+                
+                return hash;
+            }
+            
+        }; // end struct NanoLabelHash
+        
+        // Case insensitive comparison for split IDs, matching NanoLabelHash
+        struct NanoLabelEqual
+        {
+            bool operator() (const std::string& ID, const std::string& OtherID) const
+            {
+                return (ID.length() == OtherID.length()) and matches(ID, OtherID.c_str());
+            }
+            
+            // Compares an ID against a lowercase C string without creating any temporary strings
+            static bool matches (const std::string& ID, const char* LowercaseID)
+            {
+                for (unsigned int item=0; item<ID.length(); ++item)
+                {
+                    if ((LowercaseID[item] == 0) or (::tolower(static_cast<unsigned char>(ID[item])) != ::tolower(static_cast<unsigned char>(LowercaseID[item]))))
+                    {
+                        return false;
+                    }
                 }
+                
+                return LowercaseID[ID.length()] == 0;
+            }
+            
+        }; // end struct NanoLabelEqual
+        
+        // Entry in the label table, holds the normalized ID and where it was last recorded
+        struct NanoLabelRecord
+        {
+            NanoLabelRecord (const std::string& Name) : name(Name) {}
+            
+            // The normalized (lowercase) split ID
+            std::string name;
+            
+            // Indices of the first and the latest split recorded with this label, -1 if none
+            int first = -1;
+            int last = -1;
+            
+        }; // end struct NanoLabelRecord
+        
+        // Pair of label handles for the "start ID" and "stop ID" splits of a benchmark stage
+        struct NanoStage
+        {
+            unsigned int start = RCH_NANOTIMER_UNLABELLED;
+            unsigned int stop = RCH_NANOTIMER_UNLABELLED;
+            
+        }; // end struct NanoStage
+        
+        // The label table, label handles are indices into this.
+        std::vector<NanoLabelRecord> labels;
+        
+        // Hash index types from split ID to label handle, and from stage ID to its start and stop labels.
+        typedef std::unordered_map<std::string,unsigned int,NanoLabelHash,NanoLabelEqual> NanoLabelIndex;
+        typedef std::unordered_map<std::string,NanoStage,NanoLabelHash,NanoLabelEqual> NanoStageIndex;
+        
+        // Hash index from split ID to label handle.
+        NanoLabelIndex labelIndex;
+        
+        // Hash index from stage ID to the labels of its "start ID" and "stop ID" splits.
+        NanoStageIndex stages;
+        
+        // Adds a new ID to the label table and its hash indices, returns the new label handle.
+        const NanoLabel registerLabel (std::string ID)
+        {
+            // Make the ID argument lowercase, this is the only place where IDs get normalized
+            std::transform(ID.begin(), ID.end(), ID.begin(), ::tolower);
+            
+            const unsigned int handle = static_cast<unsigned int>(labels.size());
+            
+            labels.push_back(NanoLabelRecord(ID));
+            labelIndex[ID] = handle;
+            
+            // If this is the start or stop split of a benchmark stage, link it up with its stage ID
+            if (ID.compare(0, 6, "start ") == 0)
+            {
+                stages[ID.substr(6)].start = handle;
+            }
+            else if (ID.compare(0, 5, "stop ") == 0)
+            {
+                stages[ID.substr(5)].stop = handle;
+            }
+            
+            return NanoLabel(handle);
+        }
+        
+        // Shared constructor setup, registers the default labels and prepares the clock backend.
+        void initialize ()
+        {
+            // Makes sure the default start and stop IDs always occupy their reserved label handles.
+            registerLabel("start");
+            registerLabel("stop");
+            
+            // Lets the clock backend do any expensive setup (like calibration) before timing starts
+            CLOCK::prepare();
+        }
+        
+        // Returns the interval between the latest splits recorded for a stage's start and stop labels.
+        const DATATYPE stageInterval (const NanoLabel& StartLabel, const NanoLabel& StopLabel) const
+        {
+            const int index1 = labels[StartLabel.handle].last;
+            const int index2 = labels[StopLabel.handle].last;
+            
+            // If either split was not recorded, e.g. because the arena was full
+            if ((index1 == -1) or (index2 == -1))
+            {
+                return zero();
+            }
+            
+            return interval(index1, index2);
+        }
+        
+        // Resolves the name of a stored split time event from its label handle.
+        // Splits recorded without an ID are named by their sequential number.
+        const std::string name (const int& Index) const
+        {
+            const NanoLabel& splitLabel = splits[Index].label;
+            
+            if (splitLabel.handle == RCH_NANOTIMER_UNLABELLED)
+            {
+                return std::to_string(Index + 1);
+            }
+            
+            return labels[splitLabel.handle].name;
+        }
+        
+        // Convenience formatter to avoid compiler warnings about type mismatch between int / iterator.
+        const int numSplits () const
+        {
+            // Must be int and not unsigned int, since unsigned int would cause trouble with > -1 conditions
+            return static_cast<int>(splits.size());
+        }
+        
+        // Convenience function to always return zero values cast to the correct type
+        template <typename RETURNTYPE=DATATYPE>
+        const RETURNTYPE zero () const
+        {
+            return static_cast<RETURNTYPE>(0);
+        }
+        
+        // Reads the current time as raw integer clock ticks, this is all that happens on the hot path.
+        const RCH_NANOTIMER_TICKS nowTicks () const
+        {
+            return CLOCK::ticks();
+        }
+        
+        // Converts raw integer clock ticks into integer nanoseconds through the clock backend.
+        const RCH_NANOTIMER_TICKS toNanoseconds (const RCH_NANOTIMER_TICKS& Ticks) const
+        {
+            return CLOCK::nanoseconds(Ticks);
+        }
+        
+        // Convenience function to scale full precision clock ticks into higher timebase timestamps (ns to µs etc.)
+        // This is the only place where stored ticks are converted into the output number format.
+        template <typename RETURNTYPE=DATATYPE>
+        const RETURNTYPE scale (const RCH_NANOTIMER_TICKS& Ticks) const
+        {
+            return static_cast<RETURNTYPE>(NanoUnit<DATATYPE>::scale(toNanoseconds(Ticks), timebase.factor()));
+        }
+        
+        // Returns the scaled (not formatted) time difference between two valid split indices, later minus earlier.
+        const DATATYPE difference (const int& Index, const int& OtherIndex) const
+        {
+            const int later = std::max(Index,OtherIndex);
+            const int earlier = std::min(Index,OtherIndex);
+            
+            return scale(compensated(splits[later].ticks - splits[earlier].ticks, later - earlier));
+        }
+        
+        // Returns the hardware counts between two split indices, later minus earlier, if both have counter readings.
+        const NanoCounters counterDifference (const int& Index, const int& OtherIndex) const
+        {
+            const int later = std::max(Index,OtherIndex);
+            const int earlier = std::min(Index,OtherIndex);
+            
+            if ((earlier < 0) or (later >= countedSplits()))
+            {
+                return NanoCounters();
+            }
+            
+            return counterSplits[later].since(counterSplits[earlier]);
+        }
+        
+        // Number of split time events that have counter readings, zero if they don't all have one
+        const int countedSplits () const
+        {
+            return (counterSplits.size() == splits.size()) ? numSplits() : 0;
+        }
+        
+        // Subtracts the calibrated overhead of Steps split time events from a tick difference, if enabled.
+        const RCH_NANOTIMER_TICKS compensated (const RCH_NANOTIMER_TICKS& Ticks, const int& Steps) const
+        {
+            if (compensation == false)
+            {
+                return Ticks;
             }
             
-            // If no valid time interval could be generated from the queried index, return zero as default
-            return zero();
+            return std::max(static_cast<RCH_NANOTIMER_TICKS>(0), Ticks - overheadStats.ticks * Steps);
+        }
+        
+        // Starts the timer for a benchmark, or only adds a start split when a named stage joins a running timer.
+        void openBenchmark (const NanoLabel& StartLabel, const bool& Staged)
+        {
+            if ((Staged == true) and (running == true))
+            {
+                split(StartLabel);
+            }
+            else
+            {
+                start(StartLabel);
+            }
+        }
+        
+        // Stops the timer after a benchmark, or only adds a stop split for a named stage.
+        void closeBenchmark (const NanoLabel& StopLabel, const bool& Staged)
+        {
+            if (Staged == true)
+            {
+                split(StopLabel);
+            }
+            else
+            {
+                stop(StopLabel);
+            }
+        }
+        
+        // Times a call that returns nothing, returns the timed interval instead.
+        template <class FUNCTION, class... ARGUMENTS>
+        const DATATYPE timed (std::true_type, const NanoLabel& StartLabel, const NanoLabel& StopLabel, const bool& Staged, FUNCTION&& Function, ARGUMENTS&&... Arguments)
+        {
+            openBenchmark(StartLabel, Staged);
+            
+            NanoInvoke::call(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+            
+            closeBenchmark(StopLabel, Staged);
+            
+            return (Staged == true) ? stageInterval(StartLabel, StopLabel) : interval();
+        }
+        
+        // Times a call that returns a value, and forwards that value (also references and move-only types).
+        template <class FUNCTION, class... ARGUMENTS>
+        NanoInvoke::Result<FUNCTION,ARGUMENTS...> timed (std::false_type, const NanoLabel& StartLabel, const NanoLabel& StopLabel, const bool& Staged, FUNCTION&& Function, ARGUMENTS&&... Arguments)
+        {
+            openBenchmark(StartLabel, Staged);
+            
+            NanoInvoke::Result<FUNCTION,ARGUMENTS...> result = NanoInvoke::call(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+            
+            closeBenchmark(StopLabel, Staged);
+            
+            return std::forward<NanoInvoke::Result<FUNCTION,ARGUMENTS...> >(result);
+        }
+        
+        // Times a call that returns nothing in batches, returns the mean time of a single call.
+        template <class FUNCTION, class... ARGUMENTS>
+        const DATATYPE timedBatches (std::true_type, const NanoLabel& StartLabel, const NanoLabel& StopLabel, const bool& Staged, FUNCTION&& Function, ARGUMENTS&&... Arguments)
+        {
+            sampleBatches(StartLabel, StopLabel, Staged, Function, Arguments...);
+            
+            return scaleNanoseconds(batchStats.time);
         }
         
-// ------------------------------------------------------------------------------------------
-// TIME INTERVAL - SPLIT TO SPLIT
+        // Times a call that returns a value in batches, then calls it once more to forward that result.
+        template <class FUNCTION, class... ARGUMENTS>
+        NanoInvoke::Result<FUNCTION,ARGUMENTS...> timedBatches (std::false_type, const NanoLabel& StartLabel, const NanoLabel& StopLabel, const bool& Staged, FUNCTION&& Function, ARGUMENTS&&... Arguments)
+        {
+            sampleBatches(StartLabel, StopLabel, Staged, Function, Arguments...);
+            
+            return NanoInvoke::call(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+        }
         
-        /** Returns the scaled (not formatted) time difference between two split time event records.
-            The split time events are located by numbered index values.
-            Negative numbers are possible to count from the back of the split time event storage. */
-        const RCH_NANOTIMER_DATATYPE interval (const int& Split, const int& OtherSplit) const
+        // Picks the batch size, then times the configured number of batches between a start and a stop split.
+        template <class FUNCTION, class... ARGUMENTS>
+        void sampleBatches (const NanoLabel& StartLabel, const NanoLabel& StopLabel, const bool& Staged, FUNCTION& Function, ARGUMENTS&... Arguments)
         {
-            // If there are no split time events saved anyway, including start or stop
-            if (numSplits() == 0)
+            // Every call sees the same arguments again, but only after they escaped, so nothing can be hoisted
+            auto call = [&] () -> NanoInvoke::Result<FUNCTION&,ARGUMENTS&...>
             {
-                // Exit early
-                return zero();
-            }
+                escapeArguments(Arguments...);
+                
+                return NanoInvoke::call(Function, Arguments...);
+            };
             
-            // Filter out the special case where start and stop/last index are passed
-            // Irrelevant to check if both are different, (0,0) or (-1,-1) are OK to just call interval()
-            if (// If the requested first split time event index points to first or (also past) last index
-                ((Split == 0) or (Split == -1) or (Split >= numSplits()))
-                and// If the requested other split time event index points to first or (also past) last index
-                ((OtherSplit == 0) or (OtherSplit == -1) or (OtherSplit >= numSplits()))
-                )
-            {   // Since one split index is start split and one index is stop split,
-                // take the easy way out and just return the full start-to-stop interval
-                return interval();
-            }
+            const unsigned long long iterations = batchSize(call, batching.sampleTime);
             
-            // Since the Split and OtherSplit indices can be negative, figure out their true positive indexable values
-            const int split1 = (Split > -1) * Split + (Split < 0) * (numSplits() + Split);
-            const int split2 = (OtherSplit > -1) * OtherSplit + (OtherSplit < 0) * (numSplits() + OtherSplit);
+            // Per-call mean and variance over all batches (Welford)
+            double mean = 0.0;
+            double squares = 0.0;
             
-            // If both Split and OtherSplit indices are within bounds of available split time events
-            if ((split1 > -1) and (split1 < numSplits()) and (split2 > -1) and (split2 < numSplits()))
+            openBenchmark(StartLabel, Staged);
+            
+            for (unsigned int sample=1; sample<=batching.samples; ++sample)
             {
-                // Fetch the scaled (not formatted) timestamps for the two found indices, ordered by index number
-                const RCH_NANOTIMER_DATATYPE splitTimeLater = time(std::max(split1,split2));
-                const RCH_NANOTIMER_DATATYPE splitTimeEarlier = time(std::min(split1,split2));
+                const double value = static_cast<double>(toNanoseconds(compensated(runBatch(call, iterations), 1))) / static_cast<double>(iterations);
                 
-                // Return the scaled (not formatted) time difference between the
-                // larger/later split time event and the smaller/earlier split time event.
-                return static_cast<RCH_NANOTIMER_DATATYPE>(splitTimeLater - splitTimeEarlier);
+                const double delta = value - mean;
+                mean += delta / static_cast<double>(sample);
+                squares += delta * (value - mean);
             }
             
-            // If no valid time interval could be evaluated from the queried indices, return zero as default
-            return zero();
+            closeBenchmark(StopLabel, Staged);
+            
+            batchStats = NanoBatchStats();
+            batchStats.time = mean;
+            batchStats.iterations = iterations;
+            batchStats.samples = batching.samples;
+            
+            if (batching.samples > 1)
+            {
+                batchStats.error = 1.96 * std::sqrt(squares / static_cast<double>(batching.samples - 1) / static_cast<double>(batching.samples));
+            }
         }
         
-        /** Returns the scaled (not formatted) time difference between two split time event records.
-            The split time events are located by their string IDs/names. */
-        const RCH_NANOTIMER_DATATYPE interval (std::string SplitID, std::string OtherSplitID)
+        // Lets every argument of a batched call escape, see NanoBarrier::escape().
+        static inline void escapeArguments () {}
+        
+        template <class FIRST, class... REST>
+        static inline void escapeArguments (const FIRST& First, const REST&... Rest)
         {
-            // If there are no split time events saved anyway, including start or stop
-            if (numSplits() == 0)
+            NanoBarrier::escape(First);
+            
+            escapeArguments(Rest...);
+        }
+        
+        // Runs a function Iterations times between two clock reads, returns the elapsed raw clock ticks.
+        template <class FUNCTION>
+        const RCH_NANOTIMER_TICKS runBatch (FUNCTION& Function, const unsigned long long& Iterations) const
+        {
+            const RCH_NANOTIMER_TICKS begin = nowTicks();
+            
+            for (unsigned long long iteration=0; iteration<Iterations; ++iteration)
             {
-                // Exit early
-                return zero();
+                sinkCall(std::is_void<NanoInvoke::Result<FUNCTION&> >(), Function);
             }
             
-            // Make the ID arguments lowercase to match the saved ID values
-            std::transform(SplitID.begin(), SplitID.end(), SplitID.begin(), ::tolower);
-            std::transform(OtherSplitID.begin(), OtherSplitID.end(), OtherSplitID.begin(), ::tolower);
+            return nowTicks() - begin;
+        }
+        
+        // Calls a function that returns nothing.
+        template <class FUNCTION>
+        static inline void sinkCall (std::true_type, FUNCTION& Function)
+        {
+            Function();
+        }
+        
+        // Calls a function and passes its result through an optimizer barrier, so the call can't be removed.
+        template <class FUNCTION>
+        static inline void sinkCall (std::false_type, FUNCTION& Function)
+        {
+            NanoBarrier::doNotOptimize(Function());
+        }
+        
+        // Finds how many calls of a function it takes for one batch to last at least SampleTime.
+        // A SampleTime of zero aims for a batch that is well above the clock's resolution.
+        template <class FUNCTION>
+        const unsigned long long batchSize (FUNCTION& Function, const std::chrono::nanoseconds& SampleTime) const
+        {
+            const RCH_NANOTIMER_TICKS target = (SampleTime.count() > 0) ? static_cast<RCH_NANOTIMER_TICKS>(SampleTime.count()) : resolution() * RCH_NANOTIMER_RESOLUTION_FACTOR;
             
-            // Try to get the indices for both passed split IDs
-            int split1 = indexFromSplitID(SplitID);
-            int split2 = indexFromSplitID(OtherSplitID);
+            unsigned long long iterations = 1;
             
-            // If both evaluated split time event indices are within a legitimate range
-            if ((split1 > -1) and (split1 < numSplits()) and (split2 > -1) and (split2 < numSplits()))
+            while (true)
             {
-                // Fetch the scaled (not formatted) timestamps for the two found indices, ordered by index number
-                const RCH_NANOTIMER_DATATYPE splitTimeLater = time(std::max(split1,split2));
-                const RCH_NANOTIMER_DATATYPE splitTimeEarlier = time(std::min(split1,split2));
+                const RCH_NANOTIMER_TICKS elapsed = toNanoseconds(runBatch(Function, iterations));
                 
-                // Return the scaled (not formatted) time difference between the
-                // larger/later split time event and the smaller/earlier split time event.
-                return static_cast<RCH_NANOTIMER_DATATYPE>(splitTimeLater - splitTimeEarlier);
+                if ((elapsed >= target) or (iterations >= (1ULL << 40)))
+                {
+                    return iterations;
+                }
+                
+                // Grow towards the target in one go if possible, but at least double and at most grow 100x
+                const double growth = (elapsed > 0) ? 1.2 * static_cast<double>(target) / static_cast<double>(elapsed) : 100.0;
+                
+                iterations = static_cast<unsigned long long>(static_cast<double>(iterations) * std::min(100.0, std::max(2.0, growth)));
             }
-            
-            // If no valid time interval could be evaluated from the queried IDs, return zero as default
-            return zero();
         }
         
-        const RCH_NANOTIMER_DATATYPE interval (std::string SplitID, const int& OtherSplitIndex)
+        // Returns the smallest step the clock backend can resolve, in nanoseconds (at least 1).
+        const RCH_NANOTIMER_TICKS resolution () const
         {
-            // Find the Index for the named split
-            int splitIndex1 = indexFromSplitID(SplitID);
+            RCH_NANOTIMER_TICKS smallest = 0;
             
-            // If no valid index for the named split was found
-            if (splitIndex1 == -1)
+            for (int probe=0; probe<1000; ++probe)
             {
-                return zero();
+                // Wait for the clock to tick over, then note by how much it changed
+                const RCH_NANOTIMER_TICKS first = nowTicks();
+                RCH_NANOTIMER_TICKS second = nowTicks();
+                
+                while (second == first)
+                {
+                    second = nowTicks();
+                }
+                
+                const RCH_NANOTIMER_TICKS step = toNanoseconds(second - first);
+                
+                if ((step > 0) and ((smallest == 0) or (step < smallest)))
+                {
+                    smallest = step;
+                }
             }
             
-            // If a valid index was found
-            return interval(splitIndex1, OtherSplitIndex);
+            return std::max(static_cast<RCH_NANOTIMER_TICKS>(1), smallest);
         }
         
-        const RCH_NANOTIMER_DATATYPE interval (const int& SplitIndex, std::string OtherSplitID)
+        // Returns the value at a fraction (0 to 1) of sorted values, interpolating between neighbours.
+        static const double percentile (const std::vector<double>& Sorted, const double& Fraction)
         {
-            // Find the Index for the named split
-            int splitIndex2 = indexFromSplitID(OtherSplitID);
-            
-            // If no valid index for the named split was found
-            if (splitIndex2 == -1)
+            if (Sorted.empty() == true)
             {
-                return zero();
+                return 0.0;
             }
             
-            // If a valid index was found
-            return interval(SplitIndex, splitIndex2);
+            const double position = Fraction * static_cast<double>(Sorted.size() - 1);
+            const unsigned int lower = static_cast<unsigned int>(position);
+            const unsigned int upper = std::min(lower + 1, static_cast<unsigned int>(Sorted.size() - 1));
+            
+            return Sorted[lower] + (Sorted[upper] - Sorted[lower]) * (position - static_cast<double>(lower));
         }
         
-// ------------------------------------------------------------------------------------------
-// BENCHMARKING - ANONYMOUS AND DISCRETE
-// Use these methods to do right here, right now testing, start and stop the timer immediately.
-        
-        /** Runs a function passed via pointer argument and measures its execution time.
-            Stop the timer completely after finishing, does not add intermediate split times.
-            This method requires an ID string to identify this benchmark stage later on.
-            The return value of this function will be the timed interval (start to end),
-            i.e. how much time passed between the function's start and its termination.
-            The benchmark function will not forward any values that may be returned from
-            the timed function. After the benchmark function finishes, the timer will have
-            split time entries with the start and stop timestamps. */
-        const RCH_NANOTIMER_DATATYPE benchmark (void(* Function)())
+        // Formats a throughput per second with a decimal prefix, e.g. "1.25 GB/s" or "830.00 M items/s".
+        static const std::string rate (const double& PerSecond, const std::string& Unit)
         {
-            // Reset and start the timer
-            start();
+            const char* const prefixes[] = { "", "K", "M", "G", "T", "P" };
             
-            // Run the function that should be benchmarked
-            Function();
+            double value = PerSecond;
+            unsigned int prefix = 0;
+            
+            while ((value >= 1000.0) and (prefix < 5))
+            {
+                value /= 1000.0;
+                ++prefix;
+            }
+            
+            char text [64];
+            
+            // Words get a space between prefix and unit, unit symbols don't: "1.25 GB/s", "830.00 M items/s"
+            const char* const separator = ((Unit.size() > 1) and (prefix > 0)) ? " " : "";
             
-            // Stop the timer but don't reset the values
-            stop();
+            std::snprintf(text, sizeof(text), "%.2f %s%s%s/s", value, prefixes[prefix], separator, Unit.c_str());
             
-            // Return the time interval that passed between start and stop
-            return interval();
+            return text;
         }
         
-        /** Runs a function passed via pointer argument and measures its execution time.
-            Stop the timer completely after finishing, does not add intermediate split times.
-            The return value from the executed function will be forwarded as the return
-            value of this function. After the benchmark function finishes, the timer will
-            have split time entries with the start and stop timestamps. */
-        template<class RETURNTYPE>
-        const RETURNTYPE benchmark (RETURNTYPE(* Function)())
+        // Appends Text and pads it with spaces to Width characters. UTF-8 labels like µs take more bytes than characters.
+        static void appendColumn (std::string& Table, const std::string& Text, const unsigned int& Width)
         {
-            // Reset and start the timer
-            start();
+            unsigned int characters = 0;
             
-            // Run the function that should be benchmarked
-            RETURNTYPE result = Function();
-            
-            // Stop the timer but don't reset the values
-            stop();
+            for (unsigned int item=0; item<Text.size(); ++item)
+            {
+                characters += ((static_cast<unsigned char>(Text[item]) & 0xC0) != 0x80);
+            }
             
-            // Forward the result that was returned from the benchmarked function
-            return result;
+            Table += Text;
+            Table.append((characters < Width) ? Width - characters : 1, ' ');
         }
         
-// ------------------------------------------------------------------------------------------
-// BENCHMARKING - NAMED AND SEQUENTIAL
-// Use these methods to do progressive, staged measurements, adding to a continuously running timer.
-        
-        /** Runs a function passed via pointer argument and measures its execution time.
-            Does NOT stop the timer after finishing, only adds splits for its own start/stop times.
-            This method requires an ID string to identify this benchmark stage later on.
-            The return value of this function will be the timed interval (start to end),
-            i.e. how much time passed between the function's start and its termination.
-            The benchmark function will not forward any values that may be returned from
-            the timed function. */
-        const RCH_NANOTIMER_DATATYPE benchmark (void(* Function)(), std::string SplitStageID)
+        // Turns per-call sample times in nanoseconds into scaled (not formatted) statistics.
+        const NanoStatistics summarize (const std::vector<double>& Samples, const unsigned long long& Iterations) const
         {
-            // If the timer isn't running yet
-            if (running == false)
+            NanoStatistics result;
+            
+            result.samples = static_cast<unsigned int>(Samples.size());
+            result.iterations = Iterations;
+            
+            if (Samples.empty() == true)
             {
-                // Reset and start the timer
-                start("start " + SplitStageID);
+                return result;
             }
-            // If the timer was already running
-            else
+            
+            for (unsigned int item=0; item<Samples.size(); ++item)
             {
-                // Add a new split for the start time of this stage
-                split("start " + SplitStageID);
+                result.values.push_back(scaleNanoseconds(Samples[item]));
             }
             
-            // Run the function that should be benchmarked
-            Function();
+            std::vector<double> sorted (Samples);
+            std::sort(sorted.begin(), sorted.end());
             
-            // Add a new split for the stop time of this stage
-            split("stop " + SplitStageID);
+            double mean = 0.0;
             
-            // Return the time interval that passed between start and stop of this stage
-            return interval("start " + SplitStageID, "stop " + SplitStageID);
-        }
-        
-        /** Runs a function passed via pointer argument and measures its execution time.
-            Does NOT stop the timer after finishing, only adds splits for its own start/stop times.
-            This method requires an ID string to identify this benchmark stage later on.
-            The return value from the executed function will be forwarded as the return
-            value of this function. After the benchmark function finishes, the timer will
-            have split time entries with the start and stop timestamps. */
-        template<class RETURNTYPE>
-        const RETURNTYPE benchmark (RETURNTYPE(* Function)(), std::string SplitStageID)
-        {
-            // If the timer isn't running yet
-            if (running == false)
+            for (unsigned int item=0; item<sorted.size(); ++item)
             {
-                // Reset and start the timer
-                start("start " + SplitStageID);
+                mean += sorted[item];
             }
-            // If the timer was already running
-            else
+            
+            mean /= static_cast<double>(sorted.size());
+            
+            double variance = 0.0;
+            
+            for (unsigned int item=0; item<sorted.size(); ++item)
+            {
+                variance += (sorted[item] - mean) * (sorted[item] - mean);
+            }
+            
+            variance /= static_cast<double>(std::max(static_cast<size_t>(1), sorted.size() - 1));
+            
+            const double median = percentile(sorted, 0.5);
+            
+            // Median absolute deviation
+            std::vector<double> deviations;
+            
+            for (unsigned int item=0; item<sorted.size(); ++item)
             {
-                // Add a new split for the start time of this stage
-                split("start " + SplitStageID);
+                deviations.push_back(std::fabs(sorted[item] - median));
             }
             
-            // Run the function that should be benchmarked
-            RETURNTYPE result = Function();
+            std::sort(deviations.begin(), deviations.end());
             
-            // Add a new split for the stop time of this stage
-            split("stop " + SplitStageID);
+            // Outliers by Tukey's fences
+            const double lowerQuartile = percentile(sorted, 0.25);
+            const double upperQuartile = percentile(sorted, 0.75);
+            const double fence = 1.5 * (upperQuartile - lowerQuartile);
+            
+            for (unsigned int item=0; item<sorted.size(); ++item)
+            {
+                result.outliers += ((sorted[item] < lowerQuartile - fence) or (sorted[item] > upperQuartile + fence));
+            }
+            
+            result.minimum = scaleNanoseconds(sorted.front());
+            result.maximum = scaleNanoseconds(sorted.back());
+            result.mean = scaleNanoseconds(mean);
+            result.median = scaleNanoseconds(median);
+            result.p90 = scaleNanoseconds(percentile(sorted, 0.90));
+            result.p99 = scaleNanoseconds(percentile(sorted, 0.99));
+            result.deviation = scaleNanoseconds(std::sqrt(variance));
+            result.mad = scaleNanoseconds(percentile(deviations, 0.5));
             
-            // Forward the result that was returned from the benchmarked function
             return result;
         }
         
-// ------------------------------------------------------------------------------------------
-// EXPORT THE CURRENTLY STORED SPLIT TIMELINE
-        
-        /** Fills one referenced vector of strings with all IDs/names and fills another vector of numbers
-            with timestamps of all split time events that are currently stored for this timer.
-            The referenced arrays will be resized to fit. If no split time events are currently in
-            storage, then the two referenced vectors will become cleared. */
-        void list (std::vector<std::string>& IDs, std::vector<RCH_NANOTIMER_DATATYPE> Timestamps)
+        // Scales a (possibly fractional) nanosecond value into the current timebase.
+        const DATATYPE scaleNanoseconds (const double& Nanoseconds) const
         {
-            IDs.resize(numSplits());
-            Timestamps.resize(numSplits());
-            
-            // Cycle through all currently stored split time events
-            for (unsigned int item=0; item<numSplits(); ++item)
-            {
-                // Add the current split time ID/name into the IDs array
-                IDs.push_back(splits[item].name);
-                
-                // Add the current split timestamp into the Timestamps array
-                Timestamps.push_back(scale(splits[item].time));
-            }
+            return NanoUnit<DATATYPE>::scale(Nanoseconds, timebase.factor());
         }
         
-        /** Returns a vector array that contains the timestamps of all split time events
-            currently stored for this timer. If no split time events are in storage, the
-            return value will be an empty vector array. */
-        const std::vector<RCH_NANOTIMER_DATATYPE> listTimes () const
+        // Splits a non-negative Value below 2^64 into its whole part and its fraction rounded to Precision
+        // digits, carrying into the whole part if the fraction rounds up to one.
+        static void splitDigits (const double& Value, const unsigned int& Precision, std::uint64_t& Integer, std::uint64_t& Fraction)
         {
-            // Initialize the empty vector array that will be returned
-            std::vector<RCH_NANOTIMER_DATATYPE> data;
+            const double whole = std::floor(Value);
             
-            // Cycle through all currently stored split time events
-            for (unsigned int item=0; item<numSplits(); ++item)
+            Integer = static_cast<std::uint64_t>(whole);
+            Fraction = static_cast<std::uint64_t>((Value - whole) * static_cast<double>(power(Precision)) + 0.5);
+            
+            if (Fraction >= power(Precision))
             {
-                // Add the current split timestamp into the return vector array
-                data.push_back(scale(splits[item].time));
+                Fraction -= power(Precision);
+                ++Integer;
             }
-            
-            // Return the populated vector array
-            // Will be a vector with 0 entries if currently no split time events stored
-            return data;
         }
         
-        /** Returns a vector array that contains the IDs/names of all split time events
-            currently stored for this timer. If no split time events are in storage, the
-            return value will be an empty vector array. */
-        const std::vector<std::string> listIds () const
+        // Returns 10 to the power of Exponent, for exponents 0 to 18, from a precomputed table
+        static const std::uint64_t power (const unsigned int& Exponent)
         {
-            // Initialize the empty vector array that will be returned
-            std::vector<std::string> data;
-            
-            // Cycle through all currently stored split time events
-            for (unsigned int item=0; item<numSplits(); ++item)
+            static const std::uint64_t powers[19] =
             {
-                // Add the current split time ID/name into the return vector array
-                data.push_back(splits[item].name);
-            }
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+                1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+                100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+                1000000000000000000ULL
+            };
             
-            // Return the populated vector array
-            // Will be a vector with 0 entries if currently no split time events stored
-            return data;
+            return powers[Exponent];
         }
         
-    private:
-        
-// ------------------------------------------------------------------------------------------
-// INTERNAL SECTION - NOT FOR USE OR ACCESS FROM OUTSIDE
-        
-        // Internally used data type for name:time records of captured split time events
-        struct NanoSplit
+        // Returns the text label of a timebase unit index
+        static const char* unitLabel (const unsigned int& Unit)
         {
-            // Convenience constructor for inline instantiation --> NanoSplit variable ("ID",123456);
-            NanoSplit (const std::string& Name, const RCH_NANOTIMER_TIMESTAMP& NanoTime) : name(Name), time(NanoTime) {}
-            
-            // The name of the captured split time event
-            const std::string name;
-            
-            // The full precision timestamp of the captured split time event
-            const RCH_NANOTIMER_TIMESTAMP time;
+            static const char* const unitLabels[6] =
+            {
+                RCH_NANOTIMER_LABELS_NANOSECONDS, RCH_NANOTIMER_LABELS_MICROSECONDS, RCH_NANOTIMER_LABELS_MILLISECONDS,
+                RCH_NANOTIMER_LABELS_SECONDS, RCH_NANOTIMER_LABELS_MINUTES, RCH_NANOTIMER_LABELS_HOURS
+            };
             
-        }; // end struct NanoSplit
+            return (Unit < 6) ? unitLabels[Unit] : "";
+        }
         
-        // Table that holds value output formatting options
-        struct NanoFormatting
+        // Appends an unsigned integer in decimal digits, without going through a temporary string
+        static void appendNumber (std::string& Output, std::uint64_t Value)
         {
-            // How many floating point values to keep in format() calls
-            unsigned int precision = RCH_NANOTIMER_DEFAULT_PRECISION;
+            char digits[20];
+            int count = 0;
             
-            // Should a timebase label be added to the value in format() calls
-            bool label = RCH_NANOTIMER_DEFAULT_DISPLAYLABEL;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + Value % 10);
+                Value /= 10;
+            }
+            while (Value > 0);
             
-        } formatting;
-        
-        // This is used to keep track if the timer is currently running or stopped.
-        bool running = false;
-        
-        // The "database" that stores all time captured split time events from (and including) start to stop.
-        std::vector<NanoSplit> splits;
-        
-        // Convenience formatter to avoid compiler warnings about type mismatch between int / iterator.
-        const int numSplits () const
-        {
-            // Must be int and not unsigned int, since unsigned int would cause trouble with > -1 conditions
-            return static_cast<int>(splits.size());
+            while (count > 0)
+            {
+                Output += digits[--count];
+            }
         }
         
-        // Convenience function to always return zero values cast to the correct type
-        template <typename RETURNTYPE=RCH_NANOTIMER_DATATYPE>
-        const RETURNTYPE zero () const
+        // Appends text with everything escaped that can't stand in a JSON string as it is
+        static void appendJson (std::string& Output, const std::string& Text)
         {
-            return static_cast<RETURNTYPE>(0);
+            static const char hex[] = "0123456789abcdef";
+            
+            for (unsigned int item=0; item<Text.size(); ++item)
+            {
+                const unsigned char character = static_cast<unsigned char>(Text[item]);
+                
+                if ((character == '"') or (character == '\\'))
+                {
+                    Output += '\\';
+                    Output += static_cast<char>(character);
+                }
+                else if (character < 0x20)
+                {
+                    Output += "\\u00";
+                    Output += hex[character >> 4];
+                    Output += hex[character & 0x0F];
+                }
+                else
+                {
+                    Output += static_cast<char>(character);
+                }
+            }
         }
         
-        // Convenience macro to scale full precision time stamps into higher timebase timestamps (ns to µs etc.)
-        template <typename RETURNTYPE=RCH_NANOTIMER_DATATYPE>
-        const RETURNTYPE scale (const RCH_NANOTIMER_TIMESTAMP& Time) const
+        // Turns a possibly negative split index into a positive array index, returns -1 if out of bounds
+        const int indexFromPosition (const int& Number) const
         {
-            return std::chrono::time_point_cast<std::chrono::nanoseconds>(Time).time_since_epoch().count() / timebase.factor();
+            const int splitIndex = Number + (Number < 0) * numSplits();
+            
+            if ((splitIndex > -1) and (splitIndex < numSplits()))
+            {
+                return splitIndex;
+            }
+            
+            return -1;
         }
         
         // Returns -1 if no split with this ID found, returns number index if split with this ID found
-        const int indexFromSplitID (std::string SplitID) const
+        const int indexFromSplitID (const std::string& SplitID) const
         {
             // Default --> no split time with this ID found
             int foundIndex = -1;
@@ -849,40 +6022,110 @@ namespace RCH
                 return foundIndex;
             }
             
-            // Make the ID argument lowercase to match the saved ID values
-            std::transform(SplitID.begin(), SplitID.end(), SplitID.begin(), ::tolower);
+            // If a label with this ID exists, take the latest split recorded with it
+            const typename NanoLabelIndex::const_iterator found = labelIndex.find(SplitID);
+            
+            if (found != labelIndex.end())
+            {
+                foundIndex = labels[found->second].last;
+            }
+            
+            // Splits without a label are named by their sequential number, the later match wins
+            foundIndex = std::max(foundIndex, indexFromSequentialID(SplitID));
             
-            // Handle special case for start split directly
-            if ((SplitID == "start") or (SplitID == "begin") or (SplitID == splits.front().name))
+            // If no split carries this ID, handle special cases for start and stop splits
+            if (foundIndex == -1)
             {
-                foundIndex = 0;
+                if (NanoLabelEqual::matches(SplitID, "start") or NanoLabelEqual::matches(SplitID, "begin"))
+                {
+                    foundIndex = 0;
+                }
+                else if (NanoLabelEqual::matches(SplitID, "stop") or NanoLabelEqual::matches(SplitID, "end"))
+                {
+                    foundIndex = numSplits() - 1;
+                }
             }
-            // Handle special case for stop split directly
-            else if ((SplitID == "stop") or (SplitID == "end") or (SplitID == splits.back().name))
+            
+            return foundIndex;
+        }
+        
+        // Returns the index of an unlabelled split addressed by its sequential number, -1 if there is none
+        const int indexFromSequentialID (const std::string& SplitID) const
+        {
+            // Sequential numbers are only plain digits, and not too long to fit into an int
+            if ((SplitID.empty() == true) or (SplitID.length() > 9))
             {
-                foundIndex = numSplits() - 1;
+                return -1;
             }
             
-            // If queried ID was not that of start or stop splits, cycle through all splits
-            for (unsigned int item=0; item<numSplits(); ++item)
+            int number = 0;
+            
+            for (unsigned int item=0; item<SplitID.length(); ++item)
             {
-                // Check if the current split's name matches the ID we're looking for
-                if (splits[item].name == SplitID)
+                if ((SplitID[item] < '0') or (SplitID[item] > '9'))
                 {
-                    foundIndex = item;
+                    return -1;
                 }
+                
+                number = number * 10 + (SplitID[item] - '0');
             }
             
-            return foundIndex;
+            // Sequential numbers start at 1, and only count for splits that have no label
+            if ((number < 1) or (number > numSplits()) or (splits[number - 1].label.handle != RCH_NANOTIMER_UNLABELLED))
+            {
+                return -1;
+            }
+            
+            return number - 1;
         }
         
-    }; // end class RCH::NanoTimer
+    }; // end class RCH::BasicNanoTimer
+    
+    /** High precision timer that returns timestamps and intervals in the default number format. */
+    typedef BasicNanoTimer<> NanoTimer;
+    
+    /** High precision timer that reads the CPU's time stamp counter, for very short measurements. */
+    typedef BasicNanoTimer<RCH_NANOTIMER_DATATYPE,NanoTscClock> NanoTscTimer;
+    
+    /** High precision timer with its unit fixed at compile time, PERIOD is a std::ratio like std::milli.
+        All timestamps and intervals are returned as std::chrono::duration<REP,PERIOD> values. */
+    template <class PERIOD, typename REP=double, class CLOCK=NanoSystemClock>
+    using NanoUnitTimer = BasicNanoTimer<std::chrono::duration<REP,PERIOD>,CLOCK>;
     
 } // end namespace RCH
 
 
+// Times the rest of the enclosing block as a named stage of a timer, see BasicNanoTimer::scope().
+// Stage is either a stage ID string, or better, label handles fetched once through stage().
+// Define RCH_NANOTIMER_DISABLE_INSTRUMENTATION before including this file to compile all of these out.
+// The Stage argument is then left unevaluated, it's only mentioned to avoid unused variable warnings.
+#if defined(RCH_NANOTIMER_DISABLE_INSTRUMENTATION)
+    #define RCH_NANOTIMER_SCOPE(Timer,Stage) static_cast<void>(sizeof(Stage))
+#else
+    #define RCH_NANOTIMER_SCOPE(Timer,Stage) const auto RCH_NANOTIMER_SCOPE_NAME(__COUNTER__) = (Timer).scope(Stage)
+#endif
+
+// Gives every scope object a unique name, so several can be used in one block
+#define RCH_NANOTIMER_SCOPE_NAME(Number) RCH_NANOTIMER_SCOPE_JOIN(rchNanoScope, Number)
+#define RCH_NANOTIMER_SCOPE_JOIN(Name,Number) Name##Number
+
+
 // Just cleaning up
 #undef RCH_NANOTIMER_TIMESTAMP
+#undef RCH_NANOTIMER_TICKS
+#undef RCH_NANOTIMER_HAS_TSC
+#undef RCH_NANOTIMER_TSC_CALIBRATION_ROUNDS
+#undef RCH_NANOTIMER_TSC_CALIBRATION_SPAN
+#undef RCH_NANOTIMER_DEFAULT_HISTOGRAM_DIGITS
+#undef RCH_NANOTIMER_DEFAULT_HISTOGRAM_HIGHEST
+#undef RCH_NANOTIMER_DEFAULT_SIGNIFICANCE
+#undef RCH_NANOTIMER_DEFAULT_THRESHOLD
+#undef RCH_NANOTIMER_DEFAULT_RESAMPLES
+#undef RCH_NANOTIMER_TRACE_BUFFER
+#undef RCH_NANOTIMER_BUFFER_CACHE
+#undef RCH_NANOTIMER_UNLABELLED
+#undef RCH_NANOTIMER_LABEL_START
+#undef RCH_NANOTIMER_LABEL_STOP
 #undef RCH_NANOTIMER_DATATYPE
 #undef RCH_NANOTIMER_NANO
 #undef RCH_NANOTIMER_MCRO
@@ -892,8 +6135,28 @@ namespace RCH
 #undef RCH_NANOTIMER_LABELS_MICROSECONDS
 #undef RCH_NANOTIMER_LABELS_MILLISECONDS
 #undef RCH_NANOTIMER_LABELS_SECONDS
+#undef RCH_NANOTIMER_LABELS_MINUTES
+#undef RCH_NANOTIMER_LABELS_HOURS
+#undef RCH_NANOTIMER_UNIT_NANOSECONDS
+#undef RCH_NANOTIMER_UNIT_MICROSECONDS
+#undef RCH_NANOTIMER_UNIT_MILLISECONDS
+#undef RCH_NANOTIMER_UNIT_SECONDS
+#undef RCH_NANOTIMER_UNIT_MINUTES
+#undef RCH_NANOTIMER_UNIT_HOURS
+#undef RCH_NANOTIMER_UNIT_AUTOMATIC
+#undef RCH_NANOTIMER_FORMAT_LENGTH
 #undef RCH_NANOTIMER_DEFAULT_PRECISION
 #undef RCH_NANOTIMER_DEFAULT_DISPLAYLABEL
+#undef RCH_NANOTIMER_DEFAULT_CALIBRATION_SAMPLES
+#undef RCH_NANOTIMER_DEFAULT_WARMUP
+#undef RCH_NANOTIMER_DEFAULT_MINSAMPLES
+#undef RCH_NANOTIMER_DEFAULT_MAXSAMPLES
+#undef RCH_NANOTIMER_DEFAULT_BUDGET
+#undef RCH_NANOTIMER_DEFAULT_CONFIDENCE
+#undef RCH_NANOTIMER_RESOLUTION_FACTOR
+#undef RCH_NANOTIMER_DEFAULT_SCALING_BUDGET
+#undef RCH_NANOTIMER_DEFAULT_BATCH_SAMPLES
+#undef RCH_NANOTIMER_SUITE_BAR_LENGTH
 
 
 // ---- MODULE CODE ENDS ABOVE ---- //